@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+// std::allocator replacement that aligns every allocation to Alignment bytes,
+// so a std::vector's data starts on a cache line and can be loaded with
+// aligned SIMD instructions.
+template <typename T, std::size_t Alignment = 64>
+class AlignedAllocator
+{
+    static_assert(Alignment >= alignof(T), "AlignedAllocator: Alignment below the type's own");
+    static_assert((Alignment & (Alignment - 1)) == 0, "AlignedAllocator: Alignment must be a power of two");
+
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(std::size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ Alignment }));
+    }
+
+    void deallocate(T* p, std::size_t /*count*/) noexcept {
+        ::operator delete(p, std::align_val_t{ Alignment });
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
@@ -1,57 +1,49 @@
 #include "Asteroid.h"
 #include "AsteroidComponent.h"
-#include <SFML/Graphics/RenderTarget.hpp>
+#include "World.h"
 
-Asteroid::Asteroid(int initialLevel) noexcept
-    : Entity(0.0f)
+Asteroid::Asteroid(World& world, int initialLevel) noexcept
+    : world(world),
+    initialLevel(initialLevel)
 {
-    componentId = AsteroidComponentManager::instance().create(this, initialLevel);
-    speed = AsteroidComponentManager::instance().getDefaultSpeed(componentId);
 }
 
 Asteroid::~Asteroid()
 {
-    if (componentId) AsteroidComponentManager::instance().destroy(componentId);
+    onPoolRelease();
 }
 
-void Asteroid::update(float deltaTime)
+void Asteroid::onPoolAcquire()
 {
-    if (componentId)
-    {
-        AsteroidComponentManager::instance().update(componentId, deltaTime);
-    }
+    if (componentId) return;
+
+    componentId = world.asteroids.create(this, initialLevel);
+}
+
+void Asteroid::onPoolRelease()
+{
+    if (!componentId) return;
+
+    world.asteroids.destroy(componentId);
+    componentId = 0;
 }
 
 int Asteroid::getLevel() const noexcept
 {
-    return componentId ? AsteroidComponentManager::instance().getLevel(componentId) : 0;
+    return componentId ? world.asteroids.getLevel(componentId) : 0;
 }
 
 float Asteroid::getDefaultSpeed() const noexcept
 {
-    return componentId ? AsteroidComponentManager::instance().getDefaultSpeed(componentId) : 0.0f;
+    return componentId ? world.asteroids.getDefaultSpeed(componentId) : 0.0f;
 }
 
 void Asteroid::setLevel(int newLevel) noexcept
 {
-    if (componentId) AsteroidComponentManager::instance().setLevel(componentId, newLevel);
+    if (componentId) world.asteroids.setLevel(componentId, newLevel);
 }
 
 void Asteroid::decreaseLevel() noexcept
 {
-    if (componentId) AsteroidComponentManager::instance().decreaseLevel(componentId);
-}
-
-void Asteroid::draw(sf::RenderTarget& target, sf::RenderStates states) const
-{
-    states.transform = getTransform();
-    if (componentId)
-    {
-        sf::CircleShape shapeCopy = AsteroidComponentManager::instance().getShapeCopy(componentId);
-        target.draw(shapeCopy, states);
-    }
-    else
-    {
-        Entity::draw(target, states);
-    }
+    if (componentId) world.asteroids.decreaseLevel(componentId);
 }
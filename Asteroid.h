@@ -1,16 +1,23 @@
 #pragma once
 
-#include "Entity.h"
-#include <algorithm>
+#include "ObjectPool.h"
+#include <cstddef>
 
-class Asteroid
-    : public Entity
+class World;
+
+// A pooled handle on one asteroid's component. All of its state lives in
+// World::asteroids; the simulation moves it and the renderer draws it from
+// there.
+class Asteroid : public Pooled
 {
 public:
-    explicit Asteroid(int initialLevel = 3) noexcept;
-    ~Asteroid() override;
+    explicit Asteroid(World& world, int initialLevel = 3) noexcept;
+    ~Asteroid();
 
-    void update(float deltaTime) override;
+    // Component data exists only while the asteroid is in play, so systems
+    // iterating the component manager never see pooled, idle asteroids.
+    void onPoolAcquire();
+    void onPoolRelease();
 
     int getLevel() const noexcept;
     float getDefaultSpeed() const noexcept;
@@ -18,15 +25,10 @@ public:
     void setLevel(int newLevel) noexcept;
     void decreaseLevel() noexcept;
 
-    void setDirection(const sf::Vector2f& dir) noexcept;
-    sf::Vector2f getDirection() const noexcept;
-
-    void setSpeed(float s) noexcept;
-    float getSpeed() const noexcept;
-
-protected:
-    virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    size_t getComponentId() const noexcept { return componentId; }
 
 private:
+    World& world;
     size_t componentId{ 0 };
+    int initialLevel;
 };
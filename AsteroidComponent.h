@@ -1,46 +1,239 @@
 #pragma once
 
 #include <atomic>
-#include <unordered_map>
-#include <shared_mutex>
+#include <cstdint>
+#include <mutex>
 #include <memory>
-#include <SFML/Graphics/CircleShape.hpp>
+#include <type_traits>
+#include <vector>
 #include <SFML/System/Vector2.hpp>
+#include "AlignedAllocator.h"
+#include "ColliderBatch.h"
+#include "LockPolicy.h"
+#include "SeqLock.h"
+#include "Span.h"
+#include "SparseSet.h"
 
 class Asteroid;
 
+// Per-asteroid data the movement and collision passes never read.
 struct AsteroidComponent
 {
     size_t id{};
     Asteroid* owner{ nullptr };
-    int level{ 3 };
-    float rotationSpeed{ 25.0f };
     float defaultSpeed{ 400.0f };
-    float speed{};
-    sf::Vector2f direction{};
-    sf::CircleShape shape;
 
     AsteroidComponent() = default;
 };
 
-class AsteroidComponentManager
+// Hot per-asteroid data as a Structure of Arrays: one cache-line aligned array
+// per field, all indexed like the dense side of the manager's SparseSet. A
+// pass pulls in only the fields it reads, e.g. collision touches posX, posY
+// and radius and nothing else.
+struct AsteroidColumns
 {
+    template <typename T>
+    using Column = std::vector<T, AlignedAllocator<T, 64>>;
+
+    Column<float> posX, posY;
+    Column<float> dirX, dirY, speed;
+    Column<float> radius;
+    Column<std::int32_t> level;
+    Column<float> rotation, rotationSpeed;
+
+    static constexpr std::size_t BytesPerAsteroid = 8 * sizeof(float) + sizeof(std::int32_t);
+
+    template <typename Fn>
+    void forEachColumn(Fn&& fn)
+    {
+        fn(posX); fn(posY);
+        fn(dirX); fn(dirY); fn(speed);
+        fn(radius);
+        fn(level);
+        fn(rotation); fn(rotationSpeed);
+    }
+
+    std::size_t size() const noexcept { return posX.size(); }
+
+    void reserve(std::size_t count)
+    {
+        forEachColumn([count](auto& column) { column.reserve(count); });
+    }
+
+    void pushBack()
+    {
+        forEachColumn([](auto& column) { column.emplace_back(); });
+    }
+
+    // Mirrors SparseSet::erase: the last element moves into index.
+    void swapRemove(std::size_t index)
+    {
+        forEachColumn([index](auto& column)
+        {
+            column[index] = column.back();
+            column.pop_back();
+        });
+    }
+};
+
+// What a renderer needs to draw one asteroid, copied out under the lock.
+struct AsteroidRenderState
+{
+    sf::Vector2f position{};
+    float rotation{};
+    float radius{};
+};
+
+// Writers serialize on LockPolicy (see LockPolicy.h). With a concurrent
+// policy, getters take no lock: they read optimistically and validate against
+// sequence counters (see SeqLock.h), one per stripe of StripeSize asteroids
+// plus one for structural changes, retrying if a write got in the way.
+// Readers therefore never write shared memory, and a reader only waits on
+// writes to the stripe it reads. With NullLock all of it compiles away.
+//
+// Instantiated for NullLock, SharedMutexLock and SpinRWLock in
+// AsteroidComponentManager.cpp; the game uses AsteroidComponentManager below.
+template <typename LockPolicy>
+class BasicAsteroidComponentManager
+{
+    struct Storage;
+
 public:
     using Id = size_t;
 
-    static AsteroidComponentManager& instance();
+    static constexpr float DefaultSpeed{ 400.0f };
+    static constexpr float BaseRadius{ 10.0f };
+    static constexpr float RadiusStep{ 10.0f };
+
+    static constexpr float radiusForLevel(int level) noexcept { return BaseRadius + (level > 0 ? level : 0) * RadiusStep; }
+    // Proportional to area, so a bigger asteroid shoves a smaller one aside.
+    static constexpr float massForLevel(int level) noexcept { return radiusForLevel(level) * radiusForLevel(level); }
+
+    // Initial state for an asteroid whose component already exists (see
+    // Asteroid::onPoolAcquire).
+    struct SpawnDesc
+    {
+        Id id{};
+        sf::Vector2f position{};
+        sf::Vector2f direction{};
+        int level{ 3 };
+        // Added to the asteroid's default speed.
+        float speedOffset{};
+    };
+
+    // Splits parent in two. parent drops a level; child, an asteroid already
+    // spawned, takes the new level and parent's position. Each heads along
+    // parent's direction rotated by its own angle (degrees), at the default
+    // speed plus its own offset. With child 0 the parent only drops a level.
+    struct SplitDesc
+    {
+        Id parent{};
+        Id child{};
+        float parentAngle{};
+        float childAngle{};
+        float parentSpeedOffset{};
+        float childSpeedOffset{};
+    };
+
+    // Direct access to one asteroid's fields with a single lookup, under the
+    // manager's lock for the lifetime of the object. Readers of the asteroid's
+    // stripe wait for it, so keep it short, and do not call other manager
+    // functions while an Edit is alive.
+    class Edit
+    {
+    public:
+        Edit(Edit&& other) noexcept
+            : lock_(std::move(other.lock_)), manager_(other.manager_), storage_(other.storage_), index_(other.index_)
+        {
+            other.index_ = Npos;
+        }
+        Edit(const Edit&) = delete;
+        Edit& operator=(const Edit&) = delete;
+
+        ~Edit()
+        {
+            if (index_ != Npos) endStripeWrite();
+        }
+
+        // False if the id did not resolve; no other member may be used then.
+        explicit operator bool() const noexcept { return index_ != Npos; }
+
+        sf::Vector2f getPosition() const noexcept { return { columns().posX[index_], columns().posY[index_] }; }
+        void setPosition(const sf::Vector2f& pos) noexcept { columns().posX[index_] = pos.x; columns().posY[index_] = pos.y; }
+
+        sf::Vector2f getDirection() const noexcept { return { columns().dirX[index_], columns().dirY[index_] }; }
+        void setDirection(const sf::Vector2f& dir) noexcept { columns().dirX[index_] = dir.x; columns().dirY[index_] = dir.y; }
+
+        float getSpeed() const noexcept { return columns().speed[index_]; }
+        void setSpeed(float s) noexcept { columns().speed[index_] = s; }
+        float getDefaultSpeed() const noexcept { return storage_->components.values()[index_].defaultSpeed; }
+
+        int getLevel() const noexcept { return columns().level[index_]; }
+        void setLevel(int newLevel) { manager_->applyLevelLocked(index_, newLevel); }
+        float getRadius() const noexcept { return columns().radius[index_]; }
+
+    private:
+        friend class BasicAsteroidComponentManager;
+
+        Edit(BasicAsteroidComponentManager& manager, Id id)
+            : lock_(manager.mutex_), manager_(&manager), storage_(manager.storage_.get()), index_(manager.indexOfLocked(id))
+        {
+            if (index_ != Npos) beginStripeWrite();
+        }
+
+        void beginStripeWrite() noexcept { if constexpr (LockPolicy::IsConcurrent) stripe().beginWrite(); }
+        void endStripeWrite() noexcept { if constexpr (LockPolicy::IsConcurrent) stripe().endWrite(); }
+
+        AsteroidColumns& columns() const noexcept { return storage_->columns; }
+        PaddedSeqCounter& stripe() const noexcept { return storage_->stripes[index_ / StripeSize]; }
+
+        std::unique_lock<LockPolicy> lock_;
+        BasicAsteroidComponentManager* manager_;
+        Storage* storage_;
+        std::uint32_t index_;
+    };
+
+    static constexpr std::size_t StripeSize = 64;
+
+    // Footprint of one asteroid in the manager: hot columns, cold component,
+    // the SparseSet index (sparse index and generation + dense id) and its
+    // share of a stripe counter. Raising it is a deliberate decision, hence
+    // the assert.
+    static constexpr std::size_t HotBytesPerAsteroid = AsteroidColumns::BytesPerAsteroid;
+    static constexpr std::size_t BytesPerAsteroid = HotBytesPerAsteroid + sizeof(AsteroidComponent) + 2 * sizeof(std::uint32_t) + sizeof(Id) +
+        sizeof(PaddedSeqCounter) / StripeSize;
+
+    BasicAsteroidComponentManager();
+    ~BasicAsteroidComponentManager();
+
+    BasicAsteroidComponentManager(const BasicAsteroidComponentManager&) = delete;
+    BasicAsteroidComponentManager& operator=(const BasicAsteroidComponentManager&) = delete;
 
     Id create(Asteroid* owner, int initialLevel);
     void destroy(Id id);
 
+    Edit edit(Id id);
+
+    // Apply many spawns or splits under one lock. Entries whose ids do not
+    // resolve are skipped; splits are applied in order.
+    void spawnBatch(Span<const SpawnDesc> spawns);
+    void splitBatch(Span<const SplitDesc> splits);
+
     void update(Id id, float deltaTime);
 
+    // Moves and spins every asteroid: one lock, one linear pass over the
+    // columns. This is the per-tick path; update(id) is for single entities.
+    void updateAll(float deltaTime);
+
     void setLevel(Id id, int newLevel);
     void decreaseLevel(Id id);
 
     int getLevel(Id id);
     float getDefaultSpeed(Id id);
 
+    void setPosition(Id id, const sf::Vector2f& pos);
+    sf::Vector2f getPosition(Id id);
+
     void setDirection(Id id, const sf::Vector2f& dir);
     sf::Vector2f getDirection(Id id);
 
@@ -48,9 +241,11 @@ public:
     float getSpeed(Id id);
 
     float getRadius(Id id);
-    sf::CircleShape getShapeCopy(Id id);
+    AsteroidRenderState getRenderState(Id id);
 
     Id getIdForOwner(Asteroid* owner);
+    void setPositionByOwner(Asteroid* owner, const sf::Vector2f& pos);
+    sf::Vector2f getPositionByOwner(Asteroid* owner);
     void setDirectionByOwner(Asteroid* owner, const sf::Vector2f& dir);
     void setSpeedByOwner(Asteroid* owner, float s);
     void setLevelByOwner(Asteroid* owner, int level);
@@ -60,19 +255,93 @@ public:
 
     std::vector<Id> snapshotIds();
 
+    // Replaces the contents of colliders and owners with every asteroid's
+    // position and radius and its owner, in dense order, under one lock. This
+    // is what the collision passes read instead of per-asteroid getters. The
+    // start of each asteroid's step is its current position; see
+    // gatherPositions.
+    void gatherColliders(ColliderBatch& colliders, std::vector<Asteroid*>& owners);
+
+    // Replaces the contents of posX and posY with every asteroid's position,
+    // in dense order, under one lock. Taken before updateAll, it is where each
+    // asteroid's step began.
+    void gatherPositions(ColliderBatch::Column<float>& posX, ColliderBatch::Column<float>& posY);
+
+    // Elastic collisions between touching asteroids, under one lock. Each
+    // pair names two asteroids by their index in colliders, filled by the
+    // last gatherColliders, so nothing may be created or destroyed in
+    // between. Pairs are resolved in order, each seeing the velocities the
+    // ones before it left: overlap is pushed apart in inverse proportion to
+    // mass (massForLevel), and pairs still closing exchange momentum along
+    // the line between the centres. Moved positions are written to colliders
+    // as well, so it stays current without gathering again.
+    void resolveContacts(Span<const ColliderPair> contacts, ColliderBatch& colliders);
+
 private:
-    AsteroidComponentManager() = default;
-    ~AsteroidComponentManager() = default;
+    static constexpr std::uint32_t Npos = SparseSet<AsteroidComponent, Id>::Npos;
+    static constexpr std::size_t InitialCapacity = 64;
+
+    // Everything a lock-free reader may touch. A Storage never reallocates:
+    // when it is full, the writer publishes a copy with twice the capacity and
+    // retires the old one, which stays allocated until the manager goes away
+    // because readers may still be inside it. Retired storage therefore never
+    // exceeds the size of the live one.
+    struct Storage
+    {
+        explicit Storage(std::size_t capacity);
+
+        std::size_t capacity;
+
+        // Components are packed densely and looked up by id in O(1).
+        SparseSet<AsteroidComponent, Id> components;
+        AsteroidColumns columns;
+
+        // stripes[i / StripeSize] guards the fields at dense index i.
+        std::unique_ptr<PaddedSeqCounter[]> stripes;
+    };
+
+    template <typename Counter>
+    using WriteGuard = std::conditional_t<LockPolicy::IsConcurrent, SeqWriteGuard<Counter>, NullSeqWriteGuard<Counter>>;
 
     // internal helpers
-    AsteroidComponent* findComponentLocked(Id id);
-    AsteroidComponent* findComponentShared(Id id);
+    std::uint32_t indexOfLocked(Id id) const;
+    void applyLevelLocked(std::uint32_t index, int newLevel);
+    void setVelocityLocked(std::uint32_t index, float velocityX, float velocityY);
+    void reserveLocked(std::size_t count);
 
-    mutable std::shared_mutex mutex_;
-    std::atomic<Id> nextId_{1};
-    std::unordered_map<Id, AsteroidComponent> components_;
-    std::unordered_map<Asteroid*, Id> ownerMap_;
+    WriteGuard<PaddedSeqCounter> writeStripeLocked(std::uint32_t index)
+    {
+        return WriteGuard<PaddedSeqCounter>(storage_->stripes[index / StripeSize]);
+    }
 
-    static constexpr float BaseRadius{ 10.0f };
-    static constexpr float RadiusStep{ 10.0f };
-};
\ No newline at end of file
+    // Runs read(storage, index) until it completes without a concurrent
+    // write to the asteroid. Returns false if the id does not resolve.
+    template <typename Read>
+    bool readOptimistic(Id id, Read&& read) const;
+
+    mutable LockPolicy mutex_;
+
+    // Bumped around anything that moves asteroids between dense indices or
+    // touches many at once: create, destroy, batches and storage growth.
+    SeqCounter structure_;
+
+    std::unique_ptr<Storage> storage_;
+    std::atomic<const Storage*> published_{ nullptr };
+    std::vector<std::unique_ptr<Storage>> retired_;
+
+    // Ids of destroyed components are recycled, with the next generation (see
+    // SparseId), so the sparse index stays as small as the peak asteroid
+    // count and a destroyed id never names another asteroid. Id 0 is never
+    // handed out.
+    std::vector<Id> freeIds_;
+    Id nextId_{1};
+};
+
+using AsteroidComponentManager = BasicAsteroidComponentManager<ComponentLockPolicy>;
+
+extern template class BasicAsteroidComponentManager<NullLock>;
+extern template class BasicAsteroidComponentManager<SharedMutexLock>;
+extern template class BasicAsteroidComponentManager<SpinRWLock>;
+
+static_assert(AsteroidComponentManager::HotBytesPerAsteroid <= 40, "Asteroid hot data grew: check the movement and collision passes");
+static_assert(AsteroidComponentManager::BytesPerAsteroid <= 80, "Asteroid footprint grew past its budget");
@@ -1,210 +1,544 @@
 #include "AsteroidComponent.h"
 #include "Asteroid.h"
+#include "Kinematics.h"
 #include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
 #include <vector>
 
-AsteroidComponentManager& AsteroidComponentManager::instance()
+namespace
 {
-    static AsteroidComponentManager mgr;
-    return mgr;
+    sf::Vector2f rotateDegrees(sf::Vector2f v, float degrees)
+    {
+        const float rad = degrees * 3.14159265358979323846f / 180.0f;
+        const float c = std::cos(rad), s = std::sin(rad);
+        return sf::Vector2f(v.x * c - v.y * s, v.x * s + v.y * c);
+    }
+}
+
+template <typename LockPolicy>
+BasicAsteroidComponentManager<LockPolicy>::Storage::Storage(std::size_t capacity)
+    : capacity(capacity), stripes(std::make_unique<PaddedSeqCounter[]>((capacity + StripeSize - 1) / StripeSize))
+{
+    // Ids never exceed the peak live count, so capacity + 1 sparse slots are
+    // enough and nothing a reader can see reallocates until the next grow.
+    components.reserve(capacity);
+    components.reserveIds(capacity + 1);
+    columns.reserve(capacity);
+}
+
+template <typename LockPolicy>
+BasicAsteroidComponentManager<LockPolicy>::BasicAsteroidComponentManager()
+    : storage_(std::make_unique<Storage>(InitialCapacity))
+{
+    published_.store(storage_.get(), std::memory_order_release);
 }
 
-AsteroidComponentManager::Id AsteroidComponentManager::create(Asteroid* owner, int initialLevel)
+template <typename LockPolicy>
+BasicAsteroidComponentManager<LockPolicy>::~BasicAsteroidComponentManager() = default;
+
+// Copies are validated against the structure counter, which covers the
+// id -> index lookup and the storage pointer, and against the stripe, which
+// covers the fields. Until then they may be torn and must not be used.
+template <typename LockPolicy>
+template <typename Read>
+bool BasicAsteroidComponentManager<LockPolicy>::readOptimistic(Id id, Read&& read) const
+{
+    if constexpr (!LockPolicy::IsConcurrent)
+    {
+        const std::uint32_t i = indexOfLocked(id);
+        if (i == Npos) return false;
+        read(*storage_, i);
+        return true;
+    }
+
+    for (;;)
+    {
+        const std::uint32_t structure = structure_.beginRead();
+        const Storage* s = published_.load(std::memory_order_acquire);
+        const std::uint32_t i = s->components.indexOf(id);
+
+        if (i == Npos || i >= s->capacity)
+        {
+            if (structure_.validate(structure)) return false;
+            continue;
+        }
+
+        const SeqCounter& stripe = s->stripes[i / StripeSize];
+        const std::uint32_t seq = stripe.beginRead();
+        read(*s, i);
+        if (stripe.validate(seq) && structure_.validate(structure)) return true;
+    }
+}
+
+template <typename LockPolicy>
+typename BasicAsteroidComponentManager<LockPolicy>::Id BasicAsteroidComponentManager<LockPolicy>::create(Asteroid* owner, int initialLevel)
 {
     std::unique_lock lock(mutex_);
+    if (freeIds_.empty() && nextId_ >= SparseId::SlotLimit<Id>) throw std::length_error("AsteroidComponentManager: out of ids");
+    reserveLocked(storage_->components.size() + 1);
+    WriteGuard<SeqCounter> structure(structure_);
+
+    Id id;
+    if (!freeIds_.empty()) {
+        id = freeIds_.back();
+        freeIds_.pop_back();
+    }
+    else {
+        id = nextId_++;
+    }
 
-    Id id = nextId_++;
     AsteroidComponent comp;
     comp.id = id;
     comp.owner = owner;
-    comp.level = std::max(0, initialLevel);
-    comp.rotationSpeed = 25.0f;
-    comp.defaultSpeed = 400.0f;
-    comp.speed = comp.defaultSpeed;
-    comp.direction = {0.f, 0.f};
-
-    const float radius = BaseRadius + comp.level * RadiusStep;
-    comp.shape.setRadius(radius);
-    comp.shape.setPointCount(8);
-    comp.shape.setFillColor(sf::Color(50, 50, 50));
-    comp.shape.setOutlineColor(sf::Color(100, 100, 100));
-    comp.shape.setOutlineThickness(4.0f);
-    comp.shape.setOrigin({ radius, radius });
-
-    components_.emplace(id, std::move(comp));
-    ownerMap_.emplace(owner, id);
-
-    if (owner) {
-        owner->setCollisionRadius(radius);
-        owner->setShapePointCount(8u);
-    }
+    comp.defaultSpeed = DefaultSpeed;
+
+    Storage& s = *storage_;
+    s.components.emplace(id, std::move(comp));
+    s.columns.pushBack();
+
+    const std::uint32_t i = static_cast<std::uint32_t>(s.columns.size() - 1);
+    s.columns.speed[i] = s.components.values()[i].defaultSpeed;
+    s.columns.rotationSpeed[i] = 25.0f;
+
+    applyLevelLocked(i, initialLevel);
 
     return id;
 }
 
-void AsteroidComponentManager::destroy(Id id)
+template <typename LockPolicy>
+void BasicAsteroidComponentManager<LockPolicy>::destroy(Id id)
 {
     std::unique_lock lock(mutex_);
-    auto it = components_.find(id);
-    if (it != components_.end()) {
-        if (it->second.owner) ownerMap_.erase(it->second.owner);
-        components_.erase(it);
+    const std::uint32_t i = indexOfLocked(id);
+    if (i == Npos) return;
+
+    WriteGuard<SeqCounter> structure(structure_);
+    storage_->components.erase(id);
+    storage_->columns.swapRemove(i);
+    freeIds_.push_back(SparseId::nextGeneration(id));
+}
+
+template <typename LockPolicy>
+typename BasicAsteroidComponentManager<LockPolicy>::Edit BasicAsteroidComponentManager<LockPolicy>::edit(Id id)
+{
+    return Edit(*this, id);
+}
+
+template <typename LockPolicy>
+void BasicAsteroidComponentManager<LockPolicy>::spawnBatch(Span<const SpawnDesc> spawns)
+{
+    std::unique_lock lock(mutex_);
+    WriteGuard<SeqCounter> structure(structure_);
+    AsteroidColumns& c = storage_->columns;
+    for (const SpawnDesc& spawn : spawns)
+    {
+        const std::uint32_t i = indexOfLocked(spawn.id);
+        if (i == Npos) continue;
+
+        c.posX[i] = spawn.position.x;
+        c.posY[i] = spawn.position.y;
+        c.dirX[i] = spawn.direction.x;
+        c.dirY[i] = spawn.direction.y;
+        c.speed[i] = storage_->components.values()[i].defaultSpeed + spawn.speedOffset;
+        applyLevelLocked(i, spawn.level);
+    }
+}
+
+template <typename LockPolicy>
+void BasicAsteroidComponentManager<LockPolicy>::splitBatch(Span<const SplitDesc> splits)
+{
+    std::unique_lock lock(mutex_);
+    WriteGuard<SeqCounter> structure(structure_);
+    AsteroidColumns& c = storage_->columns;
+    const AsteroidComponent* components = storage_->components.values().data();
+    for (const SplitDesc& split : splits)
+    {
+        const std::uint32_t parent = indexOfLocked(split.parent);
+        if (parent == Npos) continue;
+        if (c.level[parent] > 0) applyLevelLocked(parent, c.level[parent] - 1);
+
+        const std::uint32_t child = indexOfLocked(split.child);
+        if (child == Npos) continue;
+
+        applyLevelLocked(child, c.level[parent]);
+        c.posX[child] = c.posX[parent];
+        c.posY[child] = c.posY[parent];
+
+        const sf::Vector2f direction(c.dirX[parent], c.dirY[parent]);
+        const sf::Vector2f childDirection = rotateDegrees(direction, split.childAngle);
+        const sf::Vector2f parentDirection = rotateDegrees(direction, split.parentAngle);
+        c.dirX[child] = childDirection.x;
+        c.dirY[child] = childDirection.y;
+        c.dirX[parent] = parentDirection.x;
+        c.dirY[parent] = parentDirection.y;
+
+        c.speed[child] = components[child].defaultSpeed + split.childSpeedOffset;
+        c.speed[parent] = components[parent].defaultSpeed + split.parentSpeedOffset;
     }
 }
 
-void AsteroidComponentManager::update(Id id, float deltaTime)
+template <typename LockPolicy>
+void BasicAsteroidComponentManager<LockPolicy>::update(Id id, float deltaTime)
 {
     std::unique_lock lock(mutex_);
-    AsteroidComponent* c = findComponentLocked(id);
-    if (!c) return;
+    const std::uint32_t i = indexOfLocked(id);
+    if (i == Npos) return;
 
-    c->shape.rotate(sf::degrees(c->rotationSpeed * deltaTime));
+    auto stripe = writeStripeLocked(i);
+    AsteroidColumns& c = storage_->columns;
+    c.posX[i] += c.dirX[i] * c.speed[i] * deltaTime;
+    c.posY[i] += c.dirY[i] * c.speed[i] * deltaTime;
 
-    if (c->owner) c->owner->move(c->direction * c->speed * deltaTime);
+    c.rotation[i] += c.rotationSpeed[i] * deltaTime;
+    if (c.rotation[i] >= 360.0f) c.rotation[i] -= 360.0f;
 }
 
-void AsteroidComponentManager::setLevel(Id id, int newLevel)
+template <typename LockPolicy>
+void BasicAsteroidComponentManager<LockPolicy>::updateAll(float deltaTime)
 {
     std::unique_lock lock(mutex_);
-    AsteroidComponent* c = findComponentLocked(id);
-    if (!c) return;
-    c->level = std::max(0, newLevel);
-    const float r = BaseRadius + c->level * RadiusStep;
-    c->shape.setRadius(r);
-    c->shape.setOrigin({ r, r });
-    if (c->owner) c->owner->setCollisionRadius(r);
+
+    // One stripe at a time, so a reader only waits for the slice it reads.
+    AsteroidColumns& c = storage_->columns;
+    const std::size_t count = c.size();
+    for (std::size_t begin = 0; begin < count; begin += StripeSize)
+    {
+        const std::size_t n = std::min(StripeSize, count - begin);
+        WriteGuard<PaddedSeqCounter> stripe(storage_->stripes[begin / StripeSize]);
+
+        Kinematics::integrate(c.posX.data() + begin, c.posY.data() + begin, c.dirX.data() + begin, c.dirY.data() + begin,
+            c.speed.data() + begin, n, deltaTime);
+
+        float* rotation = c.rotation.data() + begin;
+        const float* rotationSpeed = c.rotationSpeed.data() + begin;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const float r = rotation[i] + rotationSpeed[i] * deltaTime;
+            rotation[i] = r >= 360.0f ? r - 360.0f : r;
+        }
+    }
 }
 
-void AsteroidComponentManager::decreaseLevel(Id id)
+template <typename LockPolicy>
+void BasicAsteroidComponentManager<LockPolicy>::setLevel(Id id, int newLevel)
 {
     std::unique_lock lock(mutex_);
-    AsteroidComponent* c = findComponentLocked(id);
-    if (!c) return;
-    if (c->level > 0) --c->level;
-    const float r = BaseRadius + c->level * RadiusStep;
-    c->shape.setRadius(r);
-    c->shape.setOrigin({ r, r });
-    if (c->owner) c->owner->setCollisionRadius(r);
+    const std::uint32_t i = indexOfLocked(id);
+    if (i == Npos) return;
+    auto stripe = writeStripeLocked(i);
+    applyLevelLocked(i, newLevel);
 }
 
-int AsteroidComponentManager::getLevel(Id id)
+template <typename LockPolicy>
+void BasicAsteroidComponentManager<LockPolicy>::decreaseLevel(Id id)
 {
-    std::shared_lock lock(mutex_);
-    AsteroidComponent* c = findComponentShared(id);
-    return c ? c->level : 0;
+    std::unique_lock lock(mutex_);
+    const std::uint32_t i = indexOfLocked(id);
+    if (i == Npos) return;
+    auto stripe = writeStripeLocked(i);
+    const int level = storage_->columns.level[i];
+    if (level > 0) applyLevelLocked(i, level - 1);
 }
 
-float AsteroidComponentManager::getDefaultSpeed(Id id)
+template <typename LockPolicy>
+int BasicAsteroidComponentManager<LockPolicy>::getLevel(Id id)
 {
-    std::shared_lock lock(mutex_);
-    AsteroidComponent* c = findComponentShared(id);
-    return c ? c->defaultSpeed : 0.0f;
+    int level = 0;
+    readOptimistic(id, [&](const Storage& s, std::uint32_t i) { level = s.columns.level[i]; });
+    return level;
+}
+
+template <typename LockPolicy>
+float BasicAsteroidComponentManager<LockPolicy>::getDefaultSpeed(Id id)
+{
+    float speed = 0.0f;
+    readOptimistic(id, [&](const Storage& s, std::uint32_t i) { speed = s.components.values()[i].defaultSpeed; });
+    return speed;
 }
 
-void AsteroidComponentManager::setDirection(Id id, const sf::Vector2f& dir)
+template <typename LockPolicy>
+void BasicAsteroidComponentManager<LockPolicy>::setPosition(Id id, const sf::Vector2f& pos)
 {
     std::unique_lock lock(mutex_);
-    AsteroidComponent* c = findComponentLocked(id);
-    if (!c) return;
-    c->direction = dir;
+    const std::uint32_t i = indexOfLocked(id);
+    if (i == Npos) return;
+    auto stripe = writeStripeLocked(i);
+    storage_->columns.posX[i] = pos.x;
+    storage_->columns.posY[i] = pos.y;
 }
 
-sf::Vector2f AsteroidComponentManager::getDirection(Id id)
+template <typename LockPolicy>
+sf::Vector2f BasicAsteroidComponentManager<LockPolicy>::getPosition(Id id)
 {
-    std::shared_lock lock(mutex_);
-    AsteroidComponent* c = findComponentShared(id);
-    return c ? c->direction : sf::Vector2f{};
+    sf::Vector2f pos{};
+    readOptimistic(id, [&](const Storage& s, std::uint32_t i) { pos = { s.columns.posX[i], s.columns.posY[i] }; });
+    return pos;
 }
 
-void AsteroidComponentManager::setSpeed(Id id, float s)
+template <typename LockPolicy>
+void BasicAsteroidComponentManager<LockPolicy>::setDirection(Id id, const sf::Vector2f& dir)
 {
     std::unique_lock lock(mutex_);
-    AsteroidComponent* c = findComponentLocked(id);
-    if (!c) return;
-    c->speed = s;
+    const std::uint32_t i = indexOfLocked(id);
+    if (i == Npos) return;
+    auto stripe = writeStripeLocked(i);
+    storage_->columns.dirX[i] = dir.x;
+    storage_->columns.dirY[i] = dir.y;
 }
 
-float AsteroidComponentManager::getSpeed(Id id)
+template <typename LockPolicy>
+sf::Vector2f BasicAsteroidComponentManager<LockPolicy>::getDirection(Id id)
 {
-    std::shared_lock lock(mutex_);
-    AsteroidComponent* c = findComponentShared(id);
-    return c ? c->speed : 0.0f;
+    sf::Vector2f dir{};
+    readOptimistic(id, [&](const Storage& s, std::uint32_t i) { dir = { s.columns.dirX[i], s.columns.dirY[i] }; });
+    return dir;
 }
 
-float AsteroidComponentManager::getRadius(Id id)
+template <typename LockPolicy>
+void BasicAsteroidComponentManager<LockPolicy>::setSpeed(Id id, float s)
 {
-    std::shared_lock lock(mutex_);
-    AsteroidComponent* c = findComponentShared(id);
-    return c ? c->shape.getRadius() : 0.0f;
+    std::unique_lock lock(mutex_);
+    const std::uint32_t i = indexOfLocked(id);
+    if (i == Npos) return;
+    auto stripe = writeStripeLocked(i);
+    storage_->columns.speed[i] = s;
 }
 
-sf::CircleShape AsteroidComponentManager::getShapeCopy(Id id)
+template <typename LockPolicy>
+float BasicAsteroidComponentManager<LockPolicy>::getSpeed(Id id)
 {
-    std::shared_lock lock(mutex_);
-    AsteroidComponent* c = findComponentShared(id);
-    return c ? c->shape : sf::CircleShape{};
+    float speed = 0.0f;
+    readOptimistic(id, [&](const Storage& s, std::uint32_t i) { speed = s.columns.speed[i]; });
+    return speed;
 }
 
-AsteroidComponentManager::Id AsteroidComponentManager::getIdForOwner(Asteroid* owner)
+template <typename LockPolicy>
+float BasicAsteroidComponentManager<LockPolicy>::getRadius(Id id)
 {
-    std::shared_lock lock(mutex_);
-    auto it = ownerMap_.find(owner);
-    return (it != ownerMap_.end()) ? it->second : 0;
+    float radius = 0.0f;
+    readOptimistic(id, [&](const Storage& s, std::uint32_t i) { radius = s.columns.radius[i]; });
+    return radius;
+}
+
+template <typename LockPolicy>
+AsteroidRenderState BasicAsteroidComponentManager<LockPolicy>::getRenderState(Id id)
+{
+    AsteroidRenderState state{};
+    readOptimistic(id, [&](const Storage& s, std::uint32_t i)
+    {
+        state = AsteroidRenderState{ { s.columns.posX[i], s.columns.posY[i] }, s.columns.rotation[i], s.columns.radius[i] };
+    });
+    return state;
+}
+
+template <typename LockPolicy>
+typename BasicAsteroidComponentManager<LockPolicy>::Id BasicAsteroidComponentManager<LockPolicy>::getIdForOwner(Asteroid* owner)
+{
+    return owner ? owner->getComponentId() : 0;
+}
+
+template <typename LockPolicy>
+void BasicAsteroidComponentManager<LockPolicy>::setPositionByOwner(Asteroid* owner, const sf::Vector2f& pos)
+{
+    Id id = getIdForOwner(owner);
+    if (id) setPosition(id, pos);
 }
 
-void AsteroidComponentManager::setDirectionByOwner(Asteroid* owner, const sf::Vector2f& dir)
+template <typename LockPolicy>
+sf::Vector2f BasicAsteroidComponentManager<LockPolicy>::getPositionByOwner(Asteroid* owner)
+{
+    Id id = getIdForOwner(owner);
+    return id ? getPosition(id) : sf::Vector2f{};
+}
+
+template <typename LockPolicy>
+void BasicAsteroidComponentManager<LockPolicy>::setDirectionByOwner(Asteroid* owner, const sf::Vector2f& dir)
 {
     Id id = getIdForOwner(owner);
     if (id) setDirection(id, dir);
 }
 
-void AsteroidComponentManager::setSpeedByOwner(Asteroid* owner, float s)
+template <typename LockPolicy>
+void BasicAsteroidComponentManager<LockPolicy>::setSpeedByOwner(Asteroid* owner, float s)
 {
     Id id = getIdForOwner(owner);
     if (id) setSpeed(id, s);
 }
 
-void AsteroidComponentManager::setLevelByOwner(Asteroid* owner, int level)
+template <typename LockPolicy>
+void BasicAsteroidComponentManager<LockPolicy>::setLevelByOwner(Asteroid* owner, int level)
 {
     Id id = getIdForOwner(owner);
     if (id) setLevel(id, level);
 }
 
-int AsteroidComponentManager::getLevelByOwner(Asteroid* owner)
+template <typename LockPolicy>
+int BasicAsteroidComponentManager<LockPolicy>::getLevelByOwner(Asteroid* owner)
 {
     Id id = getIdForOwner(owner);
     return id ? getLevel(id) : 0;
 }
 
-float AsteroidComponentManager::getDefaultSpeedByOwner(Asteroid* owner)
+template <typename LockPolicy>
+float BasicAsteroidComponentManager<LockPolicy>::getDefaultSpeedByOwner(Asteroid* owner)
 {
     Id id = getIdForOwner(owner);
     return id ? getDefaultSpeed(id) : 0.0f;
 }
 
-float AsteroidComponentManager::getRadiusByOwner(Asteroid* owner)
+template <typename LockPolicy>
+float BasicAsteroidComponentManager<LockPolicy>::getRadiusByOwner(Asteroid* owner)
 {
     Id id = getIdForOwner(owner);
     return id ? getRadius(id) : 0.0f;
 }
 
-std::vector<AsteroidComponentManager::Id> AsteroidComponentManager::snapshotIds()
+template <typename LockPolicy>
+std::vector<typename BasicAsteroidComponentManager<LockPolicy>::Id> BasicAsteroidComponentManager<LockPolicy>::snapshotIds()
+{
+    std::shared_lock lock(mutex_);
+    auto ids = storage_->components.ids();
+    return std::vector<Id>(ids.begin(), ids.end());
+}
+
+template <typename LockPolicy>
+void BasicAsteroidComponentManager<LockPolicy>::gatherColliders(ColliderBatch& colliders, std::vector<Asteroid*>& owners)
+{
+    std::shared_lock lock(mutex_);
+    const Storage& s = *storage_;
+    const AsteroidColumns& c = s.columns;
+
+    colliders.posX.assign(c.posX.begin(), c.posX.end());
+    colliders.posY.assign(c.posY.begin(), c.posY.end());
+    colliders.radius.assign(c.radius.begin(), c.radius.end());
+    colliders.startX.assign(c.posX.begin(), c.posX.end());
+    colliders.startY.assign(c.posY.begin(), c.posY.end());
+
+    owners.clear();
+    for (const AsteroidComponent& component : s.components.values()) owners.push_back(component.owner);
+}
+
+template <typename LockPolicy>
+void BasicAsteroidComponentManager<LockPolicy>::gatherPositions(ColliderBatch::Column<float>& posX, ColliderBatch::Column<float>& posY)
 {
     std::shared_lock lock(mutex_);
-    std::vector<Id> out;
-    out.reserve(components_.size());
-    for (auto const& kv : components_) out.push_back(kv.first);
-    return out;
+    const AsteroidColumns& c = storage_->columns;
+    posX.assign(c.posX.begin(), c.posX.end());
+    posY.assign(c.posY.begin(), c.posY.end());
+}
+
+template <typename LockPolicy>
+void BasicAsteroidComponentManager<LockPolicy>::resolveContacts(Span<const ColliderPair> contacts, ColliderBatch& colliders)
+{
+    std::unique_lock lock(mutex_);
+    WriteGuard<SeqCounter> structure(structure_);
+    AsteroidColumns& c = storage_->columns;
+    const std::uint32_t count = static_cast<std::uint32_t>(std::min(c.size(), colliders.size()));
+
+    for (const ColliderPair& contact : contacts)
+    {
+        const std::uint32_t a = contact.first, b = contact.second;
+        if (a >= count || b >= count) continue;
+
+        float normalX = c.posX[b] - c.posX[a];
+        float normalY = c.posY[b] - c.posY[a];
+        const float distance = std::sqrt(normalX * normalX + normalY * normalY);
+        const float penetration = c.radius[a] + c.radius[b] - distance;
+        if (penetration < 0.0f) continue;
+
+        if (distance > 0.0f)
+        {
+            normalX /= distance;
+            normalY /= distance;
+        }
+        else
+        {
+            normalX = 1.0f;
+            normalY = 0.0f;
+        }
+
+        const float inverseMassA = 1.0f / massForLevel(c.level[a]);
+        const float inverseMassB = 1.0f / massForLevel(c.level[b]);
+        const float shareA = inverseMassA / (inverseMassA + inverseMassB);
+
+        c.posX[a] -= normalX * penetration * shareA;
+        c.posY[a] -= normalY * penetration * shareA;
+        c.posX[b] += normalX * penetration * (1.0f - shareA);
+        c.posY[b] += normalY * penetration * (1.0f - shareA);
+        colliders.posX[a] = c.posX[a];
+        colliders.posY[a] = c.posY[a];
+        colliders.posX[b] = c.posX[b];
+        colliders.posY[b] = c.posY[b];
+
+        float velocityAX = c.dirX[a] * c.speed[a], velocityAY = c.dirY[a] * c.speed[a];
+        float velocityBX = c.dirX[b] * c.speed[b], velocityBY = c.dirY[b] * c.speed[b];
+        const float closing = (velocityBX - velocityAX) * normalX + (velocityBY - velocityAY) * normalY;
+        if (closing >= 0.0f) continue;
+
+        const float impulse = -2.0f * closing / (inverseMassA + inverseMassB);
+        velocityAX -= normalX * impulse * inverseMassA;
+        velocityAY -= normalY * impulse * inverseMassA;
+        velocityBX += normalX * impulse * inverseMassB;
+        velocityBY += normalY * impulse * inverseMassB;
+
+        setVelocityLocked(a, velocityAX, velocityAY);
+        setVelocityLocked(b, velocityBX, velocityBY);
+    }
 }
 
-AsteroidComponent* AsteroidComponentManager::findComponentLocked(Id id)
+template <typename LockPolicy>
+void BasicAsteroidComponentManager<LockPolicy>::setVelocityLocked(std::uint32_t index, float velocityX, float velocityY)
 {
-    auto it = components_.find(id);
-    return it != components_.end() ? &it->second : nullptr;
+    AsteroidColumns& c = storage_->columns;
+    const float speed = std::sqrt(velocityX * velocityX + velocityY * velocityY);
+    c.speed[index] = speed;
+    // A stopped asteroid keeps its heading.
+    if (speed > 0.0f)
+    {
+        c.dirX[index] = velocityX / speed;
+        c.dirY[index] = velocityY / speed;
+    }
 }
 
-AsteroidComponent* AsteroidComponentManager::findComponentShared(Id id)
+template <typename LockPolicy>
+std::uint32_t BasicAsteroidComponentManager<LockPolicy>::indexOfLocked(Id id) const
 {
-    auto it = components_.find(id);
-    return it != components_.end() ? &it->second : nullptr;
-}
\ No newline at end of file
+    return storage_->components.indexOf(id);
+}
+
+// Grows by publishing a bigger copy. With a concurrent policy the old storage
+// is retired, not freed, since a reader may have loaded it just before the
+// swap.
+template <typename LockPolicy>
+void BasicAsteroidComponentManager<LockPolicy>::reserveLocked(std::size_t count)
+{
+    const Storage& current = *storage_;
+    if (count <= current.capacity) return;
+
+    const std::size_t capacity = std::max(count, current.capacity * 2);
+    auto next = std::make_unique<Storage>(capacity);
+    next->components = current.components;
+    next->components.reserve(capacity);
+    next->components.reserveIds(capacity + 1);
+    next->columns = current.columns;
+    next->columns.reserve(capacity);
+
+    WriteGuard<SeqCounter> structure(structure_);
+    published_.store(next.get(), std::memory_order_release);
+    if constexpr (LockPolicy::IsConcurrent) retired_.push_back(std::move(storage_));
+    storage_ = std::move(next);
+}
+
+// The radius follows the level.
+template <typename LockPolicy>
+void BasicAsteroidComponentManager<LockPolicy>::applyLevelLocked(std::uint32_t index, int newLevel)
+{
+    storage_->columns.level[index] = std::max(0, newLevel);
+    storage_->columns.radius[index] = radiusForLevel(newLevel);
+}
+
+template class BasicAsteroidComponentManager<NullLock>;
+template class BasicAsteroidComponentManager<SharedMutexLock>;
+template class BasicAsteroidComponentManager<SpinRWLock>;
@@ -0,0 +1,149 @@
+// Per-tick cost of asteroid-asteroid collisions as Simulation::collideAsteroids
+// runs them, from 1k to 50k asteroids at a fixed density (one per 80x80
+// units, as in the other collision benchmarks), in us per tick and ns per
+// asteroid. Flat ns per asteroid is linear scaling.
+//
+//   persistent  SortAndSweep kept between ticks, repaired by insertion sort
+//   rebuilt     a fresh SortAndSweep every tick, i.e. a full sort
+//   brute       every pair tested, up to 5k asteroids
+//
+// Each tick moves the asteroids (updateAll), gathers their colliders, finds
+// candidate pairs, filters them with the narrowphase and resolves the
+// contacts in the AsteroidComponentManager. shifts is how far the insertion
+// sort moved circles per tick, per asteroid.
+//
+// Build: g++ -std=c++17 -O2 -ffp-contract=off -I.. -I../include AsteroidCollisionBench.cpp ../AsteroidComponentManager.cpp ../SortAndSweep.cpp ../Narrowphase.cpp ../Kinematics.cpp
+
+#include "BenchUtil.h"
+#include "../AsteroidComponent.h"
+#include "../Narrowphase.h"
+#include "../SortAndSweep.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr float Spacing = 80.0f;
+    constexpr float DeltaTime = 1.0f / 60.0f;
+    constexpr int Ticks = 30;
+    constexpr std::size_t BruteLimit = 5'000;
+
+    enum class Mode { Persistent, Rebuilt, Brute };
+
+    struct Result
+    {
+        double usPerTick;
+        double contactsPerTick;
+        double shiftsPerAsteroid;
+    };
+
+    // Same seed for every mode, so each sees the same asteroids.
+    std::unique_ptr<AsteroidComponentManager> makeAsteroids(std::size_t count)
+    {
+        auto asteroids = std::make_unique<AsteroidComponentManager>();
+        std::mt19937 rng(5);
+        const float side = Spacing * std::sqrt(static_cast<float>(count));
+        std::uniform_real_distribution<float> position(0.0f, side);
+        std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+        std::uniform_real_distribution<float> speedOffset(-300.0f, 0.0f);
+        std::uniform_int_distribution<int> level(0, 3);
+
+        std::vector<AsteroidComponentManager::SpawnDesc> spawns(count);
+        for (AsteroidComponentManager::SpawnDesc& spawn : spawns)
+        {
+            const float heading = angle(rng);
+            spawn.level = level(rng);
+            spawn.id = asteroids->create(nullptr, spawn.level);
+            spawn.position = { position(rng), position(rng) };
+            spawn.direction = { std::cos(heading), std::sin(heading) };
+            spawn.speedOffset = speedOffset(rng);
+        }
+        asteroids->spawnBatch(Span<const AsteroidComponentManager::SpawnDesc>(spawns));
+        return asteroids;
+    }
+
+    void bruteForcePairs(const ColliderBatch& colliders, std::vector<ColliderPair>& out)
+    {
+        const std::uint32_t count = static_cast<std::uint32_t>(colliders.size());
+        for (std::uint32_t a = 0; a < count; ++a)
+        {
+            for (std::uint32_t b = a + 1; b < count; ++b) out.push_back({ a, b });
+        }
+    }
+
+    Result run(std::size_t count, Mode mode)
+    {
+        std::unique_ptr<AsteroidComponentManager> asteroids = makeAsteroids(count);
+        ColliderBatch colliders;
+        std::vector<Asteroid*> owners;
+        SortAndSweep sweep;
+        std::vector<ColliderPair> pairs, contacts;
+
+        const auto collide = [&]
+        {
+            asteroids->updateAll(DeltaTime);
+            asteroids->gatherColliders(colliders, owners);
+
+            pairs.clear();
+            if (mode == Mode::Brute)
+            {
+                bruteForcePairs(colliders, pairs);
+            }
+            else
+            {
+                if (mode == Mode::Rebuilt) sweep = SortAndSweep{};
+                sweep.update(colliders);
+                sweep.findPairs(pairs);
+            }
+            Narrowphase::filterPairs(colliders, pairs, contacts);
+            std::sort(contacts.begin(), contacts.end(), [](const ColliderPair& a, const ColliderPair& b)
+            {
+                return a.first != b.first ? a.first < b.first : a.second < b.second;
+            });
+            asteroids->resolveContacts(Span<const ColliderPair>(contacts), colliders);
+        };
+
+        // The first tick sorts from scratch in every mode.
+        collide();
+
+        std::size_t contactTotal = 0, shiftTotal = 0;
+        Stopwatch timer;
+        for (int t = 0; t < Ticks; ++t)
+        {
+            collide();
+            contactTotal += contacts.size();
+            shiftTotal += sweep.getLastShifts();
+        }
+        const double seconds = timer.elapsedSeconds();
+
+        return { seconds * 1e6 / Ticks, static_cast<double>(contactTotal) / Ticks,
+            static_cast<double>(shiftTotal) / (static_cast<double>(Ticks) * count) };
+    }
+}
+
+int main()
+{
+    std::printf("asteroid-asteroid collisions per tick, one per %.0fx%.0f units (lower is better)\n\n", Spacing, Spacing);
+
+    for (std::size_t count : { 1'000u, 5'000u, 10'000u, 20'000u, 50'000u })
+    {
+        const Result persistent = run(count, Mode::Persistent);
+        const Result rebuilt = run(count, Mode::Rebuilt);
+
+        std::printf("%zu asteroids, %.0f contacts per tick\n", count, persistent.contactsPerTick);
+        printRow("persistent", persistent.usPerTick, "us");
+        printRow("persistent per asteroid", persistent.usPerTick * 1e3 / count, "ns");
+        printRow("persistent shifts per asteroid", persistent.shiftsPerAsteroid, "");
+        printRow("rebuilt", rebuilt.usPerTick, "us");
+        printRow("rebuilt per asteroid", rebuilt.usPerTick * 1e3 / count, "ns");
+        if (count <= BruteLimit)
+        {
+            const Result brute = run(count, Mode::Brute);
+            printRow("brute", brute.usPerTick, "us");
+        }
+    }
+}
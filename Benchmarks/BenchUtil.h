@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+// Minimal helpers shared by the standalone benchmark programs in this folder.
+
+class Stopwatch
+{
+public:
+    Stopwatch() : start(std::chrono::steady_clock::now()) {}
+
+    double elapsedSeconds() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start;
+};
+
+// Keeps the optimizer from discarding a computed value. Publishing only the
+// address is not enough on GCC/Clang, which then skip computing the value.
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+    (void)sink;
+#endif
+}
+
+inline void printRow(const char* label, double value, const char* unit)
+{
+    std::printf("  %-44s %12.2f %s\n", label, value, unit);
+}
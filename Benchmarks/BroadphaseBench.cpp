@@ -0,0 +1,168 @@
+// SpatialHash versus LooseQuadtree (see Broadphase.h) on the operations the
+// interface offers: build, 200 bullet queries plus the player, 100 nearest
+// queries, and pair enumeration, in us.
+//
+// Scenes:
+//   uniform  asteroids of levels 1-3 spread at the game's density
+//   waves    the spawn pattern of Simulation::trySpawnAsteroid: asteroids
+//            enter from the edges aimed near the centre and are caught at
+//            random points of their path, so density peaks mid-arena
+//   zones    waves plus 1% zone-sized (300) circles, the radius spread that
+//            forces the hash to coarse cells
+//
+// Build: g++ -std=c++17 -O2 -I.. BroadphaseBench.cpp ../SpatialHash.cpp ../LooseQuadtree.cpp
+
+#include "BenchUtil.h"
+#include "../Broadphase.h"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr double AreaPerAsteroid = 1920.0 * 1080.0 / 50.0;
+    constexpr int QueryCount = 201;
+    constexpr int NearestCount = 100;
+
+    enum class Pattern { Uniform, Waves, Zones };
+
+    const char* patternName(Pattern pattern)
+    {
+        switch (pattern)
+        {
+        case Pattern::Uniform: return "uniform";
+        case Pattern::Waves: return "waves";
+        case Pattern::Zones: return "zones";
+        }
+        return "";
+    }
+
+    struct Scene
+    {
+        ColliderBatch asteroids;
+        std::vector<float> queryX, queryY, queryRadius;
+    };
+
+    Scene makeScene(Pattern pattern, std::size_t count)
+    {
+        const float side = static_cast<float>(std::sqrt(AreaPerAsteroid * count));
+        std::mt19937 rng(static_cast<unsigned>(count));
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::uniform_int_distribution<int> level(1, 3);
+
+        Scene scene;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float radius = 10.0f + level(rng) * 10.0f;
+            if (pattern == Pattern::Zones && i % 100 == 0) radius = 300.0f;
+
+            if (pattern == Pattern::Uniform)
+            {
+                scene.asteroids.push(unit(rng) * side, unit(rng) * side, radius);
+                continue;
+            }
+
+            // Spawn on a random edge, aim at the centre give or take 250,
+            // and place it somewhere along the way across.
+            float x = unit(rng) * side, y = unit(rng) * side;
+            switch (rng() % 4)
+            {
+            case 0: y = 0.0f; break;
+            case 1: y = side; break;
+            case 2: x = 0.0f; break;
+            default: x = side; break;
+            }
+            const float targetX = side * 0.5f + (unit(rng) - 0.5f) * 500.0f;
+            const float targetY = side * 0.5f + (unit(rng) - 0.5f) * 500.0f;
+            const float travelled = unit(rng) * 1.5f;
+            scene.asteroids.push(x + (targetX - x) * travelled, y + (targetY - y) * travelled, radius);
+        }
+
+        for (int q = 0; q < QueryCount; ++q)
+        {
+            scene.queryX.push_back(unit(rng) * side);
+            scene.queryY.push_back(unit(rng) * side);
+            scene.queryRadius.push_back(q + 1 == QueryCount ? 30.0f : 5.0f);
+        }
+        return scene;
+    }
+
+    struct Result
+    {
+        double build, query, nearest, pairs;
+        std::size_t pairCount;
+    };
+
+    template <typename Fn>
+    double usPerCall(Fn&& fn)
+    {
+        int calls = 0;
+        Stopwatch timer;
+        do
+        {
+            fn();
+            ++calls;
+        } while (timer.elapsedSeconds() < 0.1);
+        return timer.elapsedSeconds() * 1e6 / calls;
+    }
+
+    template <typename Broadphase>
+    Result run(const Scene& scene)
+    {
+        Broadphase broadphase;
+        std::vector<std::uint32_t> candidates;
+        std::vector<ColliderPair> pairs;
+        Result result{};
+
+        result.build = usPerCall([&] { broadphase.build(scene.asteroids); });
+
+        result.query = usPerCall([&]
+        {
+            candidates.clear();
+            for (int q = 0; q < QueryCount; ++q)
+            {
+                broadphase.queryCircle(scene.queryX[q], scene.queryY[q], scene.queryRadius[q], candidates);
+            }
+            doNotOptimize(candidates.size());
+        });
+
+        result.nearest = usPerCall([&]
+        {
+            std::uint32_t sum = 0;
+            for (int q = 0; q < NearestCount; ++q) sum += broadphase.nearest(scene.queryX[q], scene.queryY[q]);
+            doNotOptimize(sum);
+        });
+
+        result.pairs = usPerCall([&]
+        {
+            pairs.clear();
+            broadphase.findPairs(pairs);
+        });
+        result.pairCount = pairs.size();
+
+        return result;
+    }
+}
+
+int main()
+{
+    std::printf("us per operation (lower is better); candidate pairs in brackets\n");
+    std::printf("  %-26s %10s %10s %10s %12s\n", "", "build", "201 query", "100 near", "pairs");
+
+    for (Pattern pattern : { Pattern::Uniform, Pattern::Waves, Pattern::Zones })
+    {
+        for (std::size_t count : { 1'000, 10'000, 50'000 })
+        {
+            const Scene scene = makeScene(pattern, count);
+            std::printf("\n%s, %zu asteroids\n", patternName(pattern), count);
+
+            const Result hash = run<SpatialHash>(scene);
+            std::printf("  %-26s %10.1f %10.1f %10.1f %12.1f [%zu]\n", "SpatialHash", hash.build, hash.query, hash.nearest, hash.pairs, hash.pairCount);
+
+            const Result tree = run<LooseQuadtree>(scene);
+            std::printf("  %-26s %10.1f %10.1f %10.1f %12.1f [%zu]\n", "LooseQuadtree", tree.build, tree.query, tree.nearest, tree.pairs, tree.pairCount);
+        }
+    }
+}
@@ -0,0 +1,118 @@
+// Cost of building, copying and invoking callbacks through std::function versus
+// InplaceFunction, and heap allocations on the EventBus input path.
+//
+// Build: g++ -std=c++17 -O2 -I.. CallbackBench.cpp
+
+#include "BenchUtil.h"
+#include "../EventBus.h"
+#include "../InputEvents.h"
+#include "../InplaceFunction.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <vector>
+
+namespace
+{
+    std::atomic<long long> allocations{0};
+}
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace
+{
+    constexpr int Iterations = 5'000'000;
+
+    // Roughly what a UI or gameplay handler captures: an owner and some state.
+    struct Capture
+    {
+        void* owner;
+        float x, y;
+        int id;
+        long long* sink;
+    };
+
+    template <typename Callback>
+    void benchCallback(const char* label)
+    {
+        long long sink = 0;
+        const Capture capture{ nullptr, 1.0f, 2.0f, 3, &sink };
+
+        const long long allocBefore = allocations;
+        Stopwatch buildTimer;
+        std::vector<Callback> callbacks;
+        callbacks.reserve(64);
+        for (int i = 0; i < Iterations / 64; ++i)
+        {
+            callbacks.clear();
+            for (int j = 0; j < 64; ++j)
+            {
+                callbacks.emplace_back([capture](const KeyEvent& e) { *capture.sink += e.key + capture.id; });
+            }
+        }
+        const double buildNs = buildTimer.elapsedSeconds() * 1e9 / Iterations;
+        const long long buildAllocs = allocations - allocBefore;
+
+        Stopwatch callTimer;
+        for (int i = 0; i < Iterations; ++i) callbacks[i & 63](KeyEvent{ i, KeyEvent::Action::Press });
+        const double callNs = callTimer.elapsedSeconds() * 1e9 / Iterations;
+
+        doNotOptimize(sink);
+        std::printf("%s\n", label);
+        printRow("construct", buildNs, "ns");
+        printRow("invoke", callNs, "ns");
+        printRow("heap allocations per construct", static_cast<double>(buildAllocs) / Iterations, "");
+    }
+
+    void benchBusInputPath()
+    {
+        EventBus bus;
+        long long sink = 0;
+        const Capture capture{ nullptr, 1.0f, 2.0f, 3, &sink };
+        for (int i = 0; i < 4; ++i)
+        {
+            bus.subscribe<MouseEvent>([capture](const MouseEvent& e) { *capture.sink += static_cast<long long>(e.x) + capture.id; });
+        }
+
+        // Warm both queue buffers up, then count what a steady-state frame costs.
+        for (int round = 0; round < 2; ++round)
+        {
+            for (int i = 0; i < 256; ++i) bus.enqueue(MouseEvent{ 0, 0, 0, MouseEvent::Action::ButtonPress });
+            bus.drain();
+        }
+
+        const long long allocBefore = allocations;
+        Stopwatch timer;
+        for (int frame = 0; frame < Iterations / 64; ++frame)
+        {
+            for (int i = 0; i < 64; ++i)
+            {
+                bus.enqueue(MouseEvent{ static_cast<float>(i), 0, -1, i % 8 ? MouseEvent::Action::Move : MouseEvent::Action::ButtonPress });
+            }
+            bus.drain();
+        }
+        const double ns = timer.elapsedSeconds() * 1e9 / Iterations;
+
+        doNotOptimize(sink);
+        std::printf("EventBus enqueue + drain, 4 handlers\n");
+        printRow("per input event", ns, "ns");
+        printRow("heap allocations", static_cast<double>(allocations - allocBefore), "");
+    }
+}
+
+int main()
+{
+    benchCallback<std::function<void(const KeyEvent&)>>("std::function, 32-byte capture");
+    benchCallback<InplaceFunction<void(const KeyEvent&), EventHandlerCapacity>>("InplaceFunction, 32-byte capture");
+    benchBusInputPath();
+}
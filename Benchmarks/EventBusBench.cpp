@@ -0,0 +1,115 @@
+// Cross-thread event handoff: N producer threads feeding one consumer that
+// delivers to a handler, through EventBus::post()/drain() versus a queue
+// guarded by a single std::mutex (how the bus serialized publishers before).
+//
+// Build: g++ -std=c++17 -O2 -pthread -I.. EventBusBench.cpp
+
+#include "BenchUtil.h"
+#include "../EventBus.h"
+#include "../InputEvents.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr int EventsPerProducer = 500'000;
+
+    double benchMutex(unsigned producers)
+    {
+        EventBus bus;
+        std::mutex mutex;
+        std::vector<KeyEvent> queue;
+        std::vector<KeyEvent> batch;
+        long long delivered = 0;
+        long long checksum = 0;
+        bus.subscribe<KeyEvent>([&](const KeyEvent& e) { checksum += e.key; ++delivered; });
+
+        const long long expected = static_cast<long long>(producers) * EventsPerProducer;
+
+        Stopwatch timer;
+        std::vector<std::thread> threads;
+        for (unsigned p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&]
+            {
+                for (int i = 0; i < EventsPerProducer; ++i)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    queue.push_back(KeyEvent{ i, KeyEvent::Action::Press });
+                }
+            });
+        }
+
+        while (delivered < expected)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                std::swap(queue, batch);
+            }
+            for (const KeyEvent& e : batch) bus.publish(e);
+            if (batch.empty()) std::this_thread::yield();
+            batch.clear();
+        }
+        for (auto& t : threads) t.join();
+
+        doNotOptimize(checksum);
+        return expected / timer.elapsedSeconds();
+    }
+
+    double benchIngress(unsigned producers, IngressStats& stats)
+    {
+        EventBus bus;
+        bus.channel<KeyEvent>().setIngressCapacity(1 << 14);
+
+        long long delivered = 0;
+        long long checksum = 0;
+        bus.subscribe<KeyEvent>([&](const KeyEvent& e) { checksum += e.key; ++delivered; });
+
+        const long long expected = static_cast<long long>(producers) * EventsPerProducer;
+
+        Stopwatch timer;
+        std::vector<std::thread> threads;
+        for (unsigned p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&]
+            {
+                // A full queue counts as a drop; back off and retry so every
+                // event is delivered and the runs are comparable.
+                for (int i = 0; i < EventsPerProducer; ++i)
+                {
+                    while (!bus.post(KeyEvent{ i, KeyEvent::Action::Press })) std::this_thread::yield();
+                }
+            });
+        }
+
+        while (delivered < expected)
+        {
+            const long long before = delivered;
+            bus.drain();
+            if (delivered == before) std::this_thread::yield();
+        }
+        for (auto& t : threads) t.join();
+
+        stats = bus.ingressStats<KeyEvent>();
+        doNotOptimize(checksum);
+        return expected / timer.elapsedSeconds();
+    }
+}
+
+int main()
+{
+    std::printf("events delivered per second (hardware threads: %u)\n\n", std::thread::hardware_concurrency());
+
+    for (unsigned producers : { 1u, 2u, 4u, 8u })
+    {
+        IngressStats stats;
+        std::printf("%u producer(s)\n", producers);
+        printRow("std::mutex + vector", benchMutex(producers) / 1e6, "M/s");
+        printRow("EventBus::post + drain", benchIngress(producers, stats) / 1e6, "M/s");
+        std::printf("    ingress: capacity %zu, high-water %zu, rejected pushes %llu\n",
+            stats.capacity, stats.highWater, static_cast<unsigned long long>(stats.dropped));
+    }
+}
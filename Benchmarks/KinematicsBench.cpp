@@ -0,0 +1,101 @@
+// Throughput of the Kinematics integration paths (scalar, SSE2, AVX2) in
+// elements per nanosecond, from an L1-resident batch to 1M elements, and a
+// check that every path matches the scalar result bit for bit.
+//
+// Build: g++ -std=c++17 -O2 -ffp-contract=off -I.. KinematicsBench.cpp ../Kinematics.cpp
+
+#include "BenchUtil.h"
+#include "../Kinematics.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+namespace
+{
+    using Integrate = void (*)(float*, float*, const float*, const float*, const float*, std::size_t, float);
+
+    struct PathEntry
+    {
+        Kinematics::Path path;
+        Integrate fn;
+    };
+
+    const PathEntry Paths[] = {
+        { Kinematics::Path::Scalar, &Kinematics::integrateScalar },
+        { Kinematics::Path::SSE2, &Kinematics::integrateSSE2 },
+        { Kinematics::Path::AVX2, &Kinematics::integrateAVX2 },
+    };
+
+    Kinematics::Batch makeBatch(std::size_t count)
+    {
+        Kinematics::Batch batch;
+        batch.resize(count);
+
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> position(-2000.0f, 2000.0f);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> speed(300.0f, 500.0f);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            batch.posX[i] = position(rng);
+            batch.posY[i] = position(rng);
+            batch.dirX[i] = unit(rng);
+            batch.dirY[i] = unit(rng);
+            batch.speed[i] = speed(rng);
+        }
+        return batch;
+    }
+
+    double elementsPerNs(Integrate fn, Kinematics::Batch& batch)
+    {
+        const std::size_t count = batch.size();
+        const int rounds = static_cast<int>(std::max<std::size_t>(5, 200'000'000 / count));
+
+        fn(batch.posX.data(), batch.posY.data(), batch.dirX.data(), batch.dirY.data(), batch.speed.data(), count, 1.0f / 60.0f);
+        Stopwatch timer;
+        for (int r = 0; r < rounds; ++r)
+        {
+            fn(batch.posX.data(), batch.posY.data(), batch.dirX.data(), batch.dirY.data(), batch.speed.data(), count, 1.0f / 60.0f);
+            doNotOptimize(batch.posX[r % count]);
+        }
+        return static_cast<double>(count) * rounds / (timer.elapsedSeconds() * 1e9);
+    }
+
+    bool matchesScalar(Integrate fn)
+    {
+        // Odd size so the vector tails are exercised too.
+        Kinematics::Batch expected = makeBatch(1003);
+        Kinematics::Batch actual = expected;
+        for (int tick = 0; tick < 600; ++tick)
+        {
+            Kinematics::integrateScalar(expected.posX.data(), expected.posY.data(), expected.dirX.data(), expected.dirY.data(), expected.speed.data(), expected.size(), 1.0f / 60.0f);
+            fn(actual.posX.data(), actual.posY.data(), actual.dirX.data(), actual.dirY.data(), actual.speed.data(), actual.size(), 1.0f / 60.0f);
+        }
+        return std::memcmp(expected.posX.data(), actual.posX.data(), expected.size() * sizeof(float)) == 0 &&
+            std::memcmp(expected.posY.data(), actual.posY.data(), expected.size() * sizeof(float)) == 0;
+    }
+}
+
+int main()
+{
+    std::printf("elements per ns (higher is better), dispatch picks %s\n\n", Kinematics::pathName(Kinematics::activePath()));
+
+    for (const PathEntry& entry : Paths)
+    {
+        if (entry.path == Kinematics::Path::Scalar || !Kinematics::isSupported(entry.path)) continue;
+        std::printf("%-8s bit-identical to scalar: %s\n", Kinematics::pathName(entry.path), matchesScalar(entry.fn) ? "yes" : "NO");
+    }
+
+    for (std::size_t count : { 1'024u, 65'536u, 1'048'576u })
+    {
+        Kinematics::Batch batch = makeBatch(count);
+
+        std::printf("\n%zu elements\n", count);
+        for (const PathEntry& entry : Paths)
+        {
+            if (!Kinematics::isSupported(entry.path)) continue;
+            printRow(Kinematics::pathName(entry.path), elementsPerNs(entry.fn, batch), "elem/ns");
+        }
+    }
+}
@@ -0,0 +1,183 @@
+// Uncontended cost per operation of each AsteroidComponentManager locking
+// policy (NullLock, SharedMutexLock, SpinRWLock) for create, destroy, update
+// and get, on one thread with 10k asteroids.
+//
+// The store is a stand-in that follows the manager's synchronization exactly:
+// writers take the policy's lock and, for concurrent policies, bump the
+// structure or stripe sequence counter; getters take no lock and validate
+// against the counters, except under NullLock where they read directly. The
+// manager itself needs SFML.
+//
+// Build: g++ -std=c++17 -O2 -I.. LockPolicyBench.cpp
+
+#include "BenchUtil.h"
+#include "../LockPolicy.h"
+#include "../SeqLock.h"
+#include "../SparseSet.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+    using Id = std::size_t;
+
+    constexpr std::size_t Count = 10'000;
+    constexpr std::size_t StripeSize = 64;
+    constexpr float DeltaTime = 1.0f / 60.0f;
+    constexpr int Rounds = 200;
+
+    template <typename LockPolicy>
+    class Store
+    {
+    public:
+        Store() : stripes_(std::make_unique<PaddedSeqCounter[]>(Count / StripeSize + 1))
+        {
+            index_.reserve(Count);
+            index_.reserveIds(Count + 1);
+            for (auto* column : { &posX_, &posY_, &dirX_, &dirY_, &speed_ }) column->reserve(Count);
+        }
+
+        void create(Id id)
+        {
+            std::unique_lock lock(lock_);
+            Guard<SeqCounter> structure(structure_);
+            index_.emplace(id, 0);
+            posX_.push_back(0.0f);
+            posY_.push_back(0.0f);
+            dirX_.push_back(1.0f);
+            dirY_.push_back(0.0f);
+            speed_.push_back(400.0f);
+        }
+
+        void destroy(Id id)
+        {
+            std::unique_lock lock(lock_);
+            const std::uint32_t i = index_.indexOf(id);
+            if (i == Npos) return;
+
+            Guard<SeqCounter> structure(structure_);
+            index_.erase(id);
+            for (auto* column : { &posX_, &posY_, &dirX_, &dirY_, &speed_ })
+            {
+                (*column)[i] = column->back();
+                column->pop_back();
+            }
+        }
+
+        void update(Id id)
+        {
+            std::unique_lock lock(lock_);
+            const std::uint32_t i = index_.indexOf(id);
+            if (i == Npos) return;
+
+            Guard<PaddedSeqCounter> stripe(stripes_[i / StripeSize]);
+            posX_[i] += dirX_[i] * speed_[i] * DeltaTime;
+            posY_[i] += dirY_[i] * speed_[i] * DeltaTime;
+        }
+
+        float get(Id id) const
+        {
+            if constexpr (!LockPolicy::IsConcurrent)
+            {
+                const std::uint32_t i = index_.indexOf(id);
+                return i != Npos ? posX_[i] : 0.0f;
+            }
+
+            for (;;)
+            {
+                const std::uint32_t structure = structure_.beginRead();
+                const std::uint32_t i = index_.indexOf(id);
+                if (i == Npos)
+                {
+                    if (structure_.validate(structure)) return 0.0f;
+                    continue;
+                }
+
+                const SeqCounter& stripe = stripes_[i / StripeSize];
+                const std::uint32_t seq = stripe.beginRead();
+                const float x = posX_[i];
+                if (stripe.validate(seq) && structure_.validate(structure)) return x;
+            }
+        }
+
+    private:
+        template <typename Counter>
+        using Guard = std::conditional_t<LockPolicy::IsConcurrent, SeqWriteGuard<Counter>, NullSeqWriteGuard<Counter>>;
+
+        static constexpr std::uint32_t Npos = SparseSet<char, Id>::Npos;
+
+        mutable LockPolicy lock_;
+        SeqCounter structure_;
+        std::unique_ptr<PaddedSeqCounter[]> stripes_;
+        SparseSet<char, Id> index_;
+        std::vector<float> posX_, posY_, dirX_, dirY_, speed_;
+    };
+
+    struct Result
+    {
+        double create;
+        double destroy;
+        double update;
+        double get;
+    };
+
+    template <typename LockPolicy>
+    Result run(const std::vector<Id>& order)
+    {
+        Result result{};
+        float sum = 0.0f;
+
+        for (int r = 0; r < Rounds; ++r)
+        {
+            Store<LockPolicy> store;
+
+            Stopwatch create;
+            for (Id id = 1; id <= Count; ++id) store.create(id);
+            result.create += create.elapsedSeconds();
+
+            Stopwatch update;
+            for (Id id : order) store.update(id);
+            result.update += update.elapsedSeconds();
+
+            Stopwatch get;
+            for (Id id : order) sum += store.get(id);
+            result.get += get.elapsedSeconds();
+
+            Stopwatch destroy;
+            for (Id id : order) store.destroy(id);
+            result.destroy += destroy.elapsedSeconds();
+        }
+        doNotOptimize(sum);
+
+        const double scale = 1e9 / (static_cast<double>(Count) * Rounds);
+        return { result.create * scale, result.destroy * scale, result.update * scale, result.get * scale };
+    }
+
+    void print(const char* name, const Result& result)
+    {
+        std::printf("%s\n", name);
+        printRow("create", result.create, "ns");
+        printRow("destroy", result.destroy, "ns");
+        printRow("update", result.update, "ns");
+        printRow("get", result.get, "ns");
+    }
+}
+
+int main()
+{
+    std::printf("ns per operation, %zu asteroids, one thread (lower is better)\n\n", Count);
+
+    std::vector<Id> order(Count);
+    for (Id id = 1; id <= Count; ++id) order[id - 1] = id;
+    std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+    print("NullLock", run<NullLock>(order));
+    print("SharedMutexLock", run<SharedMutexLock>(order));
+    print("SpinRWLock", run<SpinRWLock>(order));
+}
@@ -0,0 +1,121 @@
+// Per-entity asteroid updates (virtual Entity::update, a lock and an id lookup
+// per asteroid) versus one batched pass over the component columns, as done by
+// AsteroidComponentManager::updateAll, at 1k to 1M asteroids.
+//
+// Build: g++ -std=c++17 -O2 -ffp-contract=off -I.. -I../include MovementBench.cpp ../Kinematics.cpp
+
+#include "BenchUtil.h"
+#include "../AsteroidComponent.h"
+#include "../Kinematics.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace
+{
+    constexpr float DeltaTime = 1.0f / 60.0f;
+
+    // The manager's storage and both update paths, minus the Asteroid owner.
+    struct Store
+    {
+        std::shared_mutex mutex;
+        SparseSet<AsteroidComponent> components;
+        AsteroidColumns columns;
+
+        size_t create(size_t id)
+        {
+            components.emplace(id);
+            columns.pushBack();
+            const size_t i = columns.size() - 1;
+            columns.dirX[i] = 0.6f;
+            columns.dirY[i] = 0.8f;
+            columns.speed[i] = 400.0f;
+            columns.rotationSpeed[i] = 25.0f;
+            return id;
+        }
+
+        void update(size_t id, float deltaTime)
+        {
+            std::unique_lock lock(mutex);
+            const std::uint32_t i = components.indexOf(id);
+            if (i == SparseSet<AsteroidComponent>::Npos) return;
+
+            AsteroidColumns& c = columns;
+            c.posX[i] += c.dirX[i] * c.speed[i] * deltaTime;
+            c.posY[i] += c.dirY[i] * c.speed[i] * deltaTime;
+            c.rotation[i] += c.rotationSpeed[i] * deltaTime;
+            if (c.rotation[i] >= 360.0f) c.rotation[i] -= 360.0f;
+        }
+
+        void updateAll(float deltaTime)
+        {
+            std::unique_lock lock(mutex);
+
+            AsteroidColumns& c = columns;
+            const size_t count = c.size();
+            Kinematics::integrate(c.posX.data(), c.posY.data(), c.dirX.data(), c.dirY.data(), c.speed.data(), count, deltaTime);
+
+            float* rotation = c.rotation.data();
+            const float* rotationSpeed = c.rotationSpeed.data();
+            for (size_t i = 0; i < count; ++i)
+            {
+                const float r = rotation[i] + rotationSpeed[i] * deltaTime;
+                rotation[i] = r >= 360.0f ? r - 360.0f : r;
+            }
+        }
+    };
+
+    struct EntityBase
+    {
+        virtual ~EntityBase() = default;
+        virtual void update(float deltaTime) = 0;
+    };
+
+    struct AsteroidEntity : EntityBase
+    {
+        Store& store;
+        size_t id;
+
+        AsteroidEntity(Store& store, size_t id) : store(store), id(id) {}
+        void update(float deltaTime) override { store.update(id, deltaTime); }
+    };
+
+    template <typename Fn>
+    double nsPerAsteroid(size_t count, Fn fn)
+    {
+        const int rounds = static_cast<int>(std::max<size_t>(3, 20'000'000 / count));
+        fn();
+        Stopwatch timer;
+        for (int r = 0; r < rounds; ++r) fn();
+        return timer.elapsedSeconds() * 1e9 / (static_cast<double>(count) * rounds);
+    }
+}
+
+int main()
+{
+    std::printf("ns per asteroid per tick (lower is better)\n\n");
+
+    for (size_t count : { 1'000u, 10'000u, 100'000u, 1'000'000u })
+    {
+        Store store;
+        std::vector<std::unique_ptr<EntityBase>> entities;
+        for (size_t id = 1; id <= count; ++id)
+        {
+            entities.push_back(std::make_unique<AsteroidEntity>(store, store.create(id)));
+        }
+
+        const double perEntity = nsPerAsteroid(count, [&]
+        {
+            for (auto& entity : entities) entity->update(DeltaTime);
+        });
+        const double batched = nsPerAsteroid(count, [&] { store.updateAll(DeltaTime); });
+        doNotOptimize(store.columns.posX[count - 1]);
+
+        std::printf("%zu asteroids\n", count);
+        printRow("Entity::update per asteroid", perEntity, "ns");
+        printRow("updateAll", batched, "ns");
+    }
+}
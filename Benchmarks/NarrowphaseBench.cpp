@@ -0,0 +1,144 @@
+// Throughput of the Narrowphase circle-circle tests per path (scalar, SSE2,
+// AVX2) in tests per nanosecond, and a check that every path reports exactly
+// the scalar path's hits.
+//
+//   circle      one query against contiguous circles (brute-force pass)
+//   candidates  one query against circles named by an index list (after a
+//               broadphase query)
+//   pairs       candidate pairs from findPairs (scalar on every path, so
+//               only printed once)
+//
+// Build: g++ -std=c++17 -O2 -ffp-contract=off -I.. NarrowphaseBench.cpp ../Narrowphase.cpp ../Kinematics.cpp
+
+#include "BenchUtil.h"
+#include "../Narrowphase.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using Path = Narrowphase::Path;
+
+    const Path Paths[] = { Path::Scalar, Path::SSE2, Path::AVX2 };
+
+    struct Scene
+    {
+        ColliderBatch circles;
+        std::vector<std::uint32_t> candidates;
+        std::vector<ColliderPair> pairs;
+    };
+
+    // About one test in eight hits. Coordinates are whole numbers so that
+    // exact touches, the case most sensitive to rounding, come up often.
+    Scene makeScene(std::size_t count)
+    {
+        std::mt19937 rng(11);
+        const float side = 80.0f * std::sqrt(static_cast<float>(count));
+        std::uniform_real_distribution<float> position(0.0f, side);
+        std::uniform_int_distribution<int> level(1, 3);
+
+        Scene scene;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            scene.circles.push(std::round(position(rng)), std::round(position(rng)), 10.0f + level(rng) * 10.0f);
+        }
+
+        std::uniform_int_distribution<std::uint32_t> index(0, static_cast<std::uint32_t>(count - 1));
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            scene.candidates.push_back(index(rng));
+
+            std::uint32_t a = index(rng), b = index(rng);
+            if (a == b) continue;
+            if (a > b) std::swap(a, b);
+            scene.pairs.push_back({ a, b });
+        }
+        return scene;
+    }
+
+    struct Run
+    {
+        std::vector<std::uint32_t> circleHits, candidateHits;
+        std::vector<ColliderPair> pairHits;
+        double circle, candidates, pairs;
+    };
+
+    template <typename Fn>
+    double testsPerNs(std::size_t tests, Fn&& fn)
+    {
+        const int rounds = static_cast<int>(std::max<std::size_t>(5, 100'000'000 / tests));
+        Stopwatch timer;
+        for (int r = 0; r < rounds; ++r) doNotOptimize(fn(r));
+        return static_cast<double>(tests) * rounds / (timer.elapsedSeconds() * 1e9);
+    }
+
+    Run run(const Scene& scene)
+    {
+        const ColliderBatch& c = scene.circles;
+        const std::size_t count = c.size();
+        Run run;
+        run.circleHits.resize(count);
+        run.candidateHits.resize(scene.candidates.size());
+        run.pairHits.resize(scene.pairs.size());
+
+        // The query moves every round so no round repeats the last one's work.
+        auto queryX = [&](int r) { return c.posX[r % count]; };
+        auto queryY = [&](int r) { return c.posY[r % count]; };
+
+        run.circle = testsPerNs(count, [&](int r)
+        {
+            return Narrowphase::overlapCircle(queryX(r), queryY(r), 5.0f, c.posX.data(), c.posY.data(), c.radius.data(), count, run.circleHits.data());
+        });
+        run.candidates = testsPerNs(scene.candidates.size(), [&](int r)
+        {
+            return Narrowphase::overlapCandidates(queryX(r), queryY(r), 400.0f, c.posX.data(), c.posY.data(), c.radius.data(),
+                scene.candidates.data(), scene.candidates.size(), run.candidateHits.data());
+        });
+        run.pairs = testsPerNs(scene.pairs.size(), [&](int)
+        {
+            return Narrowphase::overlapPairs(c.posX.data(), c.posY.data(), c.radius.data(), scene.pairs.data(), scene.pairs.size(), run.pairHits.data());
+        });
+
+        // Leave each list as the first round's, for the comparison.
+        run.circleHits.resize(Narrowphase::overlapCircle(queryX(0), queryY(0), 5.0f, c.posX.data(), c.posY.data(), c.radius.data(), count, run.circleHits.data()));
+        run.candidateHits.resize(Narrowphase::overlapCandidates(queryX(0), queryY(0), 400.0f, c.posX.data(), c.posY.data(), c.radius.data(),
+            scene.candidates.data(), scene.candidates.size(), run.candidateHits.data()));
+        run.pairHits.resize(Narrowphase::overlapPairs(c.posX.data(), c.posY.data(), c.radius.data(), scene.pairs.data(), scene.pairs.size(), run.pairHits.data()));
+        return run;
+    }
+
+    bool sameHits(const Run& a, const Run& b)
+    {
+        return a.circleHits == b.circleHits && a.candidateHits == b.candidateHits && a.pairHits.size() == b.pairHits.size() &&
+            std::memcmp(a.pairHits.data(), b.pairHits.data(), a.pairHits.size() * sizeof(ColliderPair)) == 0;
+    }
+}
+
+int main()
+{
+    std::printf("tests per ns (higher is better), dispatch picks %s\n", Kinematics::pathName(Narrowphase::activePath()));
+
+    for (std::size_t count : { 1'003u, 65'536u, 1'048'576u })
+    {
+        const Scene scene = makeScene(count);
+        std::printf("\n%zu circles\n", count);
+
+        Run scalar;
+        for (Path path : Paths)
+        {
+            if (!Narrowphase::setActivePath(path)) continue;
+
+            const Run result = run(scene);
+            if (path == Path::Scalar) scalar = result;
+
+            std::printf("%s%s\n", Kinematics::pathName(path), path == Path::Scalar || sameHits(result, scalar) ? "" : "  HITS DIFFER FROM SCALAR");
+            printRow("circle", result.circle, "tests/ns");
+            printRow("candidates", result.candidates, "tests/ns");
+            if (path == Path::Scalar) printRow("pairs", result.pairs, "tests/ns");
+        }
+    }
+}
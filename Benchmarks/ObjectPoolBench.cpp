@@ -0,0 +1,116 @@
+// Acquire/release throughput of ObjectPool (behind a mutex once shared) versus
+// ConcurrentObjectPool with per-thread caches, at 1 to 16 threads.
+//
+// Build: g++ -std=c++17 -O2 -pthread -I.. ObjectPoolBench.cpp
+
+#include "BenchUtil.h"
+#include "../ObjectPool.h"
+#include "../ConcurrentObjectPool.h"
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct Particle : Pooled
+    {
+        float x{}, y{}, vx{}, vy{};
+    };
+
+    constexpr size_t OpsPerThread = 2'000'000;
+    constexpr size_t Burst = 16;
+
+    template <typename Worker>
+    double runThreads(unsigned threads, Worker worker)
+    {
+        std::vector<std::thread> pool;
+        Stopwatch timer;
+        for (unsigned t = 0; t < threads; ++t) pool.emplace_back(worker);
+        for (auto& th : pool) th.join();
+        return timer.elapsedSeconds();
+    }
+
+    // Each worker grabs a burst of objects, touches them and gives them back,
+    // the pattern of a system spawning short-lived fragments.
+    double benchMutexPool(unsigned threads)
+    {
+        ObjectPool<Particle> pool(threads * Burst);
+        std::mutex mutex;
+
+        const double seconds = runThreads(threads, [&]
+        {
+            Particle* held[Burst];
+            for (size_t op = 0; op < OpsPerThread; op += Burst)
+            {
+                for (size_t i = 0; i < Burst; ++i)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    held[i] = pool.acquire();
+                }
+                for (size_t i = 0; i < Burst; ++i) held[i]->x += 1.0f;
+                for (size_t i = 0; i < Burst; ++i)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    pool.release(held[i]);
+                }
+            }
+        });
+        return threads * OpsPerThread / seconds;
+    }
+
+    double benchUnsyncPool()
+    {
+        ObjectPool<Particle> pool(Burst);
+        Particle* held[Burst];
+
+        Stopwatch timer;
+        for (size_t op = 0; op < OpsPerThread; op += Burst)
+        {
+            for (size_t i = 0; i < Burst; ++i) held[i] = pool.acquire();
+            for (size_t i = 0; i < Burst; ++i) held[i]->x += 1.0f;
+            for (size_t i = 0; i < Burst; ++i) pool.release(held[i]);
+        }
+        return OpsPerThread / timer.elapsedSeconds();
+    }
+
+    double benchConcurrentPool(unsigned threads, bool cached)
+    {
+        using Pool = ConcurrentObjectPool<Particle>;
+        Pool pool(threads * (Burst + Pool::BatchSize * 2));
+
+        const double seconds = runThreads(threads, [&]
+        {
+            Pool::ThreadCache cache(pool);
+            Particle* held[Burst];
+            for (size_t op = 0; op < OpsPerThread; op += Burst)
+            {
+                for (size_t i = 0; i < Burst; ++i) held[i] = cached ? cache.acquire() : pool.acquire();
+                for (size_t i = 0; i < Burst; ++i) held[i]->x += 1.0f;
+                for (size_t i = 0; i < Burst; ++i)
+                {
+                    if (cached) cache.release(held[i]);
+                    else pool.release(held[i]);
+                }
+            }
+        });
+        return threads * OpsPerThread / seconds;
+    }
+}
+
+int main()
+{
+    std::printf("acquire+release pairs per second (hardware threads: %u)\n\n", std::thread::hardware_concurrency());
+
+    std::printf("1 thread\n");
+    printRow("ObjectPool (unsynchronized)", benchUnsyncPool() / 1e6, "M/s");
+
+    for (unsigned threads : { 1u, 2u, 4u, 8u, 16u })
+    {
+        std::printf("%u thread(s)\n", threads);
+        printRow("ObjectPool + std::mutex", benchMutexPool(threads) / 1e6, "M/s");
+        printRow("ConcurrentObjectPool (global stack only)", benchConcurrentPool(threads, false) / 1e6, "M/s");
+        printRow("ConcurrentObjectPool::ThreadCache", benchConcurrentPool(threads, true) / 1e6, "M/s");
+    }
+}
@@ -0,0 +1,186 @@
+// Position getters under contention: one writer thread moving every asteroid
+// in a loop (as updateAll does each tick) while 1 to 8 reader threads look up
+// random asteroids, guarded by a std::shared_mutex versus per-stripe
+// sequence counters as in AsteroidComponentManager.
+//
+// The store is a stand-in with the manager's layout (SparseSet index plus
+// position/direction columns); the manager itself needs SFML. With the
+// mutex, every reader writes the lock word, so readers contend with each
+// other as well as with the writer. With the counters, readers only load.
+//
+// Build: g++ -std=c++17 -O2 -pthread -I.. SeqLockBench.cpp
+
+#include "BenchUtil.h"
+#include "../SeqLock.h"
+#include "../SparseSet.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using Id = std::size_t;
+
+    constexpr std::size_t Count = 10'000;
+    constexpr std::size_t StripeSize = 64;
+    constexpr float DeltaTime = 1.0f / 60.0f;
+    constexpr double Seconds = 0.5;
+
+    struct Position
+    {
+        float x, y;
+    };
+
+    struct Store
+    {
+        SparseSet<char, Id> index;
+        std::vector<float> posX, posY, dirX, dirY;
+
+        Store()
+        {
+            for (Id id = 1; id <= Count; ++id)
+            {
+                index.emplace(id, 0);
+                posX.push_back(0.0f);
+                posY.push_back(0.0f);
+                dirX.push_back(1.0f);
+                dirY.push_back(1.0f);
+            }
+        }
+
+        void move(std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                posX[i] += dirX[i] * 400.0f * DeltaTime;
+                posY[i] += dirY[i] * 400.0f * DeltaTime;
+            }
+        }
+    };
+
+    class MutexStore
+    {
+    public:
+        void tick()
+        {
+            std::unique_lock lock(mutex_);
+            store_.move(0, Count);
+        }
+
+        Position get(Id id) const
+        {
+            std::shared_lock lock(mutex_);
+            const std::uint32_t i = store_.index.indexOf(id);
+            return { store_.posX[i], store_.posY[i] };
+        }
+
+    private:
+        mutable std::shared_mutex mutex_;
+        Store store_;
+    };
+
+    class SeqLockStore
+    {
+    public:
+        SeqLockStore() : stripes_(std::make_unique<PaddedSeqCounter[]>((Count + StripeSize - 1) / StripeSize)) {}
+
+        void tick()
+        {
+            std::unique_lock lock(writer_);
+            for (std::size_t begin = 0; begin < Count; begin += StripeSize)
+            {
+                SeqWriteGuard<PaddedSeqCounter> stripe(stripes_[begin / StripeSize]);
+                store_.move(begin, std::min(begin + StripeSize, Count));
+            }
+        }
+
+        Position get(Id id) const
+        {
+            // Ids never move between indices here, so no structure counter.
+            const std::uint32_t i = store_.index.indexOf(id);
+            const SeqCounter& stripe = stripes_[i / StripeSize];
+            for (;;)
+            {
+                const std::uint32_t seq = stripe.beginRead();
+                const Position p{ store_.posX[i], store_.posY[i] };
+                if (stripe.validate(seq)) return p;
+            }
+        }
+
+    private:
+        std::mutex writer_;
+        Store store_;
+        std::unique_ptr<PaddedSeqCounter[]> stripes_;
+    };
+
+    struct Result
+    {
+        double readsPerUs;
+        double ticksPerSecond;
+    };
+
+    template <typename S>
+    Result run(int readers)
+    {
+        S store;
+        std::atomic<bool> stop{ false };
+        std::atomic<std::uint64_t> reads{ 0 };
+        std::uint64_t ticks = 0;
+
+        std::vector<std::thread> threads;
+        for (int r = 0; r < readers; ++r)
+        {
+            threads.emplace_back([&, r]
+            {
+                std::mt19937 rng(static_cast<unsigned>(r + 1));
+                std::uniform_int_distribution<Id> pick(1, Count);
+                std::uint64_t local = 0;
+                float sum = 0.0f;
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    for (int k = 0; k < 256; ++k) sum += store.get(pick(rng)).x;
+                    local += 256;
+                }
+                doNotOptimize(sum);
+                reads.fetch_add(local);
+            });
+        }
+
+        Stopwatch timer;
+        while (timer.elapsedSeconds() < Seconds)
+        {
+            store.tick();
+            ++ticks;
+        }
+        const double elapsed = timer.elapsedSeconds();
+        stop = true;
+        for (std::thread& t : threads) t.join();
+
+        return { reads.load() / (elapsed * 1e6), ticks / elapsed };
+    }
+}
+
+int main()
+{
+    std::printf("%zu asteroids, one writer moving all of them in a loop\n", Count);
+    std::printf("reads/us across all readers and writer ticks/s (higher is better)\n\n");
+
+    for (int readers : { 1, 2, 4, 8 })
+    {
+        const Result mutex = run<MutexStore>(readers);
+        const Result seq = run<SeqLockStore>(readers);
+
+        std::printf("%d reader(s)\n", readers);
+        printRow("reads         shared_mutex", mutex.readsPerUs, "reads/us");
+        printRow("reads         seqlock", seq.readsPerUs, "reads/us");
+        printRow("writer        shared_mutex", mutex.ticksPerSecond, "ticks/s");
+        printRow("writer        seqlock", seq.ticksPerSecond, "ticks/s");
+    }
+}
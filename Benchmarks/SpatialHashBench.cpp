@@ -0,0 +1,150 @@
+// Cost of one tick of bullet and player collision queries against 10 to
+// 100k asteroids: brute force (every query against every asteroid) versus a
+// SpatialHash rebuilt every tick, as Simulation::checkCollisions does. Each
+// query finds its lowest-index hit, so both report the same hits; the
+// benchmark checks that they do.
+//
+// Asteroid density is held at the game's (about 50 on a 1920x1080 arena), so
+// the arena grows with the count. Radii follow the game's levels 1 to 3.
+// Swept for 21 queries (the 20-bullet pool plus the player) and for more
+// bullets, which moves the crossover down.
+//
+// Build: g++ -std=c++17 -O2 -I.. SpatialHashBench.cpp ../SpatialHash.cpp
+
+#include "BenchUtil.h"
+#include "../ColliderBatch.h"
+#include "../SpatialHash.h"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr double AreaPerAsteroid = 1920.0 * 1080.0 / 50.0;
+
+    struct Query
+    {
+        float x, y, radius;
+    };
+
+    struct Scene
+    {
+        ColliderBatch asteroids;
+        std::vector<Query> queries;
+    };
+
+    Scene makeScene(std::size_t asteroidCount, std::size_t queryCount)
+    {
+        const float side = static_cast<float>(std::sqrt(AreaPerAsteroid * asteroidCount));
+        std::mt19937 rng(static_cast<unsigned>(asteroidCount));
+        std::uniform_real_distribution<float> coordinate(0.0f, side);
+        std::uniform_int_distribution<int> level(1, 3);
+
+        Scene scene;
+        for (std::size_t i = 0; i < asteroidCount; ++i)
+        {
+            scene.asteroids.push(coordinate(rng), coordinate(rng), 10.0f + level(rng) * 10.0f);
+        }
+
+        // The last query is the player, the rest are bullets.
+        for (std::size_t q = 0; q < queryCount; ++q)
+        {
+            scene.queries.push_back({ coordinate(rng), coordinate(rng), q + 1 == queryCount ? 30.0f : 5.0f });
+        }
+        return scene;
+    }
+
+    bool overlaps(const ColliderBatch& asteroids, std::uint32_t i, const Query& query)
+    {
+        const float dx = query.x - asteroids.posX[i];
+        const float dy = query.y - asteroids.posY[i];
+        const float minDist = query.radius + asteroids.radius[i];
+        return dx * dx + dy * dy <= minDist * minDist;
+    }
+
+    std::uint64_t bruteForce(const Scene& scene)
+    {
+        std::uint64_t checksum = 0;
+        const std::uint32_t count = static_cast<std::uint32_t>(scene.asteroids.size());
+        for (const Query& query : scene.queries)
+        {
+            std::uint32_t first = NoCollider;
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                if (overlaps(scene.asteroids, i, query))
+                {
+                    first = i;
+                    break;
+                }
+            }
+            checksum = checksum * 31 + first;
+        }
+        return checksum;
+    }
+
+    std::uint64_t hashed(const Scene& scene, SpatialHash& grid, std::vector<std::uint32_t>& candidates)
+    {
+        grid.build(scene.asteroids);
+
+        std::uint64_t checksum = 0;
+        for (const Query& query : scene.queries)
+        {
+            candidates.clear();
+            grid.queryCircle(query.x, query.y, query.radius, candidates);
+
+            std::uint32_t first = NoCollider;
+            for (std::uint32_t i : candidates)
+            {
+                if (i < first && overlaps(scene.asteroids, i, query)) first = i;
+            }
+            checksum = checksum * 31 + first;
+        }
+        return checksum;
+    }
+
+    template <typename Fn>
+    double nsPerTick(Fn&& tick, std::uint64_t& checksum)
+    {
+        int ticks = 0;
+        Stopwatch timer;
+        do
+        {
+            checksum = tick();
+            ++ticks;
+        } while (timer.elapsedSeconds() < 0.2);
+        return timer.elapsedSeconds() * 1e9 / ticks;
+    }
+}
+
+int main()
+{
+    std::printf("us per tick, brute force vs spatial hash rebuilt every tick (lower is better)\n");
+
+    for (std::size_t queryCount : { 21, 201 })
+    {
+        std::printf("\n%zu queries (%zu bullets + player)\n", queryCount, queryCount - 1);
+        std::printf("  %-10s %12s %12s %10s\n", "asteroids", "brute", "hash", "speedup");
+
+        std::size_t crossover = 0;
+        for (std::size_t asteroidCount : { 10, 30, 100, 300, 1'000, 3'000, 10'000, 30'000, 100'000 })
+        {
+            const Scene scene = makeScene(asteroidCount, queryCount);
+            SpatialHash grid;
+            std::vector<std::uint32_t> candidates;
+
+            std::uint64_t bruteSum = 0, hashSum = 0;
+            const double brute = nsPerTick([&] { return bruteForce(scene); }, bruteSum);
+            const double hash = nsPerTick([&] { return hashed(scene, grid, candidates); }, hashSum);
+            doNotOptimize(bruteSum);
+
+            std::printf("  %-10zu %12.2f %12.2f %9.2fx%s\n", asteroidCount, brute / 1e3, hash / 1e3, brute / hash,
+                bruteSum == hashSum ? "" : "  MISMATCH");
+            if (!crossover && hash < brute) crossover = asteroidCount;
+        }
+
+        if (crossover) std::printf("  hash wins from %zu asteroids\n", crossover);
+        else std::printf("  brute force wins throughout\n");
+    }
+}
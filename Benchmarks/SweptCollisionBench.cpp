@@ -0,0 +1,139 @@
+// Bullets fired at moving asteroids, stepped at 60, 30, 15 and 10 Hz: the
+// share of bullets that hit anything when each step only tests the current
+// positions (discrete) versus the path since the last step (swept), and the
+// cost of one test of each kind in ns.
+//
+// Bullets are the game's (800 units/s, radius 5) and asteroids are the
+// smallest level (radius 10, 400 units/s), the case that tunnels first. Each
+// bullet is aimed so that its path crosses its asteroid's; the swept rate is
+// what the game registers at every tick rate.
+//
+// Build: g++ -std=c++17 -O2 -ffp-contract=off -I.. SweptCollisionBench.cpp ../Narrowphase.cpp ../Kinematics.cpp
+
+#include "BenchUtil.h"
+#include "../Narrowphase.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t Shots = 100'000;
+    constexpr float BulletSpeed = 800.0f;
+    constexpr float BulletRadius = 5.0f;
+    constexpr float AsteroidSpeed = 400.0f;
+    constexpr float AsteroidRadius = 10.0f;
+    constexpr float Flight = 1.0f;
+
+    struct Shot
+    {
+        float x, y, vx, vy;
+        float ax, ay, avx, avy;
+    };
+
+    // Bullet and asteroid would meet at a random time within the flight,
+    // give or take most of a contact distance.
+    std::vector<Shot> makeShots()
+    {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        const float pi = 3.14159265f;
+
+        std::vector<Shot> shots(Shots);
+        for (Shot& s : shots)
+        {
+            const float meet = 0.1f + 0.8f * Flight * unit(rng);
+            const float bulletAngle = 2.0f * pi * unit(rng);
+            const float asteroidAngle = 2.0f * pi * unit(rng);
+            const float miss = (unit(rng) - 0.5f) * 1.8f * (BulletRadius + AsteroidRadius);
+
+            s.vx = std::cos(bulletAngle) * BulletSpeed;
+            s.vy = std::sin(bulletAngle) * BulletSpeed;
+            s.avx = std::cos(asteroidAngle) * AsteroidSpeed;
+            s.avy = std::sin(asteroidAngle) * AsteroidSpeed;
+            s.x = 0.0f;
+            s.y = 0.0f;
+            s.ax = s.vx * meet - s.avx * meet + miss * -std::sin(bulletAngle);
+            s.ay = s.vy * meet - s.avy * meet + miss * std::cos(bulletAngle);
+        }
+        return shots;
+    }
+
+    struct Result
+    {
+        double discreteHitRate;
+        double sweptHitRate;
+    };
+
+    Result fly(const std::vector<Shot>& shots, float step)
+    {
+        const float reach = BulletRadius + AsteroidRadius;
+        const int steps = static_cast<int>(std::ceil(Flight / step));
+
+        std::size_t discreteHits = 0, sweptHits = 0;
+        for (const Shot& s : shots)
+        {
+            bool discrete = false, swept = false;
+            for (int i = 1; i <= steps && !(discrete && swept); ++i)
+            {
+                const float t0 = (i - 1) * step, t1 = i * step;
+                const float x1 = s.x + s.vx * t1, y1 = s.y + s.vy * t1;
+                const float ax1 = s.ax + s.avx * t1, ay1 = s.ay + s.avy * t1;
+
+                const float dx = x1 - ax1, dy = y1 - ay1;
+                discrete = discrete || dx * dx + dy * dy <= reach * reach;
+                swept = swept || Narrowphase::sweptContact(s.x + s.vx * t0, s.y + s.vy * t0, x1, y1,
+                    s.ax + s.avx * t0, s.ay + s.avy * t0, ax1, ay1, reach) != Narrowphase::NoContact;
+            }
+            discreteHits += discrete;
+            sweptHits += swept;
+        }
+        return { 100.0 * discreteHits / shots.size(), 100.0 * sweptHits / shots.size() };
+    }
+
+    template <typename Test>
+    double nsPerTest(const std::vector<Shot>& shots, Test&& test)
+    {
+        constexpr int Rounds = 50;
+        float sum = 0.0f;
+        Stopwatch timer;
+        for (int r = 0; r < Rounds; ++r)
+        {
+            for (const Shot& s : shots) sum += test(s);
+        }
+        const double seconds = timer.elapsedSeconds();
+        doNotOptimize(sum);
+        return seconds * 1e9 / (static_cast<double>(shots.size()) * Rounds);
+    }
+}
+
+int main()
+{
+    const std::vector<Shot> shots = makeShots();
+
+    std::printf("%% of %zu bullets that hit their asteroid (higher is better)\n\n", Shots);
+    for (int hz : { 60, 30, 15, 10 })
+    {
+        const Result result = fly(shots, 1.0f / hz);
+        std::printf("%d Hz\n", hz);
+        printRow("discrete", result.discreteHitRate, "%");
+        printRow("swept", result.sweptHitRate, "%");
+    }
+
+    const float reach = BulletRadius + AsteroidRadius;
+    const double discrete = nsPerTest(shots, [reach](const Shot& s)
+    {
+        const float dx = s.x - s.ax, dy = s.y - s.ay;
+        return dx * dx + dy * dy <= reach * reach ? 1.0f : 0.0f;
+    });
+    const double swept = nsPerTest(shots, [reach](const Shot& s)
+    {
+        return Narrowphase::sweptContact(s.x, s.y, s.x + s.vx / 60.0f, s.y + s.vy / 60.0f,
+            s.ax, s.ay, s.ax + s.avx / 60.0f, s.ay + s.avy / 60.0f, reach);
+    });
+
+    std::printf("\nns per test\n");
+    printRow("discrete", discrete, "ns");
+    printRow("swept", swept, "ns");
+}
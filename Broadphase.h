@@ -0,0 +1,39 @@
+#pragma once
+
+#include "ColliderBatch.h"
+#include "LooseQuadtree.h"
+#include "SpatialHash.h"
+
+// Broadphases over a ColliderBatch. Each one is a plain class with the same
+// members, so callers and benchmarks are written once as templates and the
+// game picks one at compile time:
+//
+//   void build(const ColliderBatch& colliders);
+//       Indexes every circle. colliders must stay alive and unchanged until
+//       the next build; queries read it.
+//
+//   void queryCircle(float x, float y, float radius, std::vector<std::uint32_t>& out) const;
+//       Appends every circle that may overlap the query circle, each once,
+//       in no particular order. May include some that do not; follow with a
+//       narrowphase test.
+//
+//   std::uint32_t nearest(float x, float y) const;
+//       The circle whose edge is nearest the point (distance to the centre
+//       less the radius, so negative inside a circle), lowest index on ties.
+//       NoCollider if there are none.
+//
+//   void findPairs(std::vector<ColliderPair>& out) const;
+//       Appends every pair of circles that may overlap, each once. May
+//       include some that do not.
+//
+// SpatialHash suits circles of similar size, LooseQuadtree a wide spread of
+// radii. Benchmarks/BroadphaseBench.cpp compares them. SortAndSweep only
+// finds pairs, and keeps its order between ticks instead of rebuilding.
+
+// Simulation::checkCollisions queries asteroids through this one; define
+// SPACEWAR_QUADTREE_BROADPHASE to switch.
+#ifdef SPACEWAR_QUADTREE_BROADPHASE
+using AsteroidBroadphase = LooseQuadtree;
+#else
+using AsteroidBroadphase = SpatialHash;
+#endif
@@ -1,14 +1,28 @@
 #include "Bullet.h"
+#include "ComponentRegistry.h"
+#include "World.h"
 
-Bullet::Bullet() : Entity(800.0f)
+Bullet::~Bullet()
 {
-	shape.setFillColor(sf::Color::Red);
-	shape.setRadius(5.0f);
-	shape.setPointCount(5);
-	shape.setOrigin({ shape.getRadius(), shape.getRadius() });
+	onPoolRelease();
 }
 
-void Bullet::update(float deltaTime)
+void Bullet::onPoolAcquire()
 {
-	move(direction * speed * deltaTime);
-}
\ No newline at end of file
+	if (id) return;
+
+	ComponentRegistry& registry = world.components;
+	id = registry.createEntity();
+	registry.transforms.add(id);
+	registry.velocities.add(id, Velocity{ {}, Speed, 0.0f });
+	registry.colliders.add(id, Collider{ Radius });
+	registry.renderables.add(id, Renderable{ Appearance::Bullet });
+}
+
+void Bullet::onPoolRelease()
+{
+	if (!id) return;
+
+	world.components.destroyEntity(id);
+	id = 0;
+}
@@ -1,13 +1,28 @@
 #pragma once
 
-#include "Entity.h"
+#include "ComponentManager.h"
+#include "ObjectPool.h"
 
-class Bullet : public Entity
+class World;
+
+// A bullet is an entity with a Transform, Velocity, Collider and Renderable.
+// This handle only ties the entity to its pool slot: the components exist
+// while the bullet is in play, so systems never see idle, pooled bullets.
+class Bullet : public Pooled
 {
 public:
-	Bullet();
+	static constexpr float Speed = 800.0f;
+	static constexpr float Radius = 5.0f;
 
-	virtual void update(float deltaTime) override;
+	explicit Bullet(World& world) : world(world) {}
+	~Bullet();
 
-};
+	void onPoolAcquire();
+	void onPoolRelease();
 
+	EntityId getId() const noexcept { return id; }
+
+private:
+	World& world;
+	EntityId id{ 0 };
+};
@@ -1,6 +1,6 @@
 #include "Button.h"
 
-Button::Button(sf::Vector2f position, sf::Vector2f size, const sf::Font& font, const std::string& label, std::function<void()> callback) :
+Button::Button(sf::Vector2f position, sf::Vector2f size, const sf::Font& font, const std::string& label, Callback callback) :
     text(font),
     color(sf::Color(100, 200, 100)),
     hoverColor(sf::Color(75, 150, 75)),
@@ -20,7 +20,7 @@ Button::Button(sf::Vector2f position, sf::Vector2f size, const sf::Font& font, c
     text.setOrigin(text.getLocalBounds().getCenter());
     text.setPosition(shape.getPosition());
 
-    onClick = callback;
+    onClick = std::move(callback);
 }
 
 void Button::update(const sf::Vector2f& mousePos, const std::optional<sf::Event>& event)
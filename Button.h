@@ -1,13 +1,15 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
-#include <functional>
+#include "InplaceFunction.h"
 
 class Button : public sf::Transformable, public sf::Drawable
 {
 
 public:
-    Button(sf::Vector2f position, sf::Vector2f size, const sf::Font& font, const std::string& label, std::function<void()> callback);
+    using Callback = InplaceFunction<void()>;
+
+    Button(sf::Vector2f position, sf::Vector2f size, const sf::Font& font, const std::string& label, Callback callback);
 
     void update(const sf::Vector2f& mousePos, const std::optional<sf::Event>& event);
 
@@ -18,7 +20,7 @@ private:
     sf::Color hoverColor;
     sf::Color pressedColor;
     bool isPressed;
-    std::function<void()> onClick;
+    Callback onClick;
 
     virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
 };
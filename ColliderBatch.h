@@ -0,0 +1,66 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "AlignedAllocator.h"
+
+// Index that names no collider, e.g. a query that found nothing.
+constexpr std::uint32_t NoCollider = ~0u;
+
+// Two colliders, by index into the same ColliderBatch, first < second.
+struct ColliderPair
+{
+    std::uint32_t first, second;
+};
+
+// Circle colliders as columns, gathered once per tick so the broadphase and
+// the narrowphase read plain arrays instead of going through a component
+// store per pair. Index i is the same circle in every column. Capacity is
+// kept between ticks, so a steady population does not allocate.
+struct ColliderBatch
+{
+    template <typename T>
+    using Column = std::vector<T, AlignedAllocator<T, 64>>;
+
+    Column<float> posX, posY;
+    Column<float> radius;
+    // Where each circle was when the step began, for swept tests; the same as
+    // posX/posY for one that did not exist yet. Broadphases ignore it.
+    Column<float> startX, startY;
+
+    std::size_t size() const noexcept { return posX.size(); }
+
+    void clear() noexcept
+    {
+        posX.clear();
+        posY.clear();
+        radius.clear();
+        startX.clear();
+        startY.clear();
+    }
+
+    void reserve(std::size_t count)
+    {
+        posX.reserve(count);
+        posY.reserve(count);
+        radius.reserve(count);
+        startX.reserve(count);
+        startY.reserve(count);
+    }
+
+    void push(float x, float y, float r)
+    {
+        posX.push_back(x);
+        posY.push_back(y);
+        radius.push_back(r);
+        startX.push_back(x);
+        startY.push_back(y);
+    }
+
+    float maxRadius() const noexcept
+    {
+        return radius.empty() ? 0.0f : *std::max_element(radius.begin(), radius.end());
+    }
+};
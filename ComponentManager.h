@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include "LockPolicy.h"
+#include "Span.h"
+#include "SparseSet.h"
+
+using EntityId = std::uint32_t;
+
+// Stores one component type for any number of entities: values are packed in
+// a SparseSet, so systems iterate a dense array and look entities up in O(1).
+// Components should be plain data; behaviour lives in the systems that
+// iterate them.
+//
+// Every member takes LockPolicy's lock (see LockPolicy.h). Callbacks run under
+// it, so they must not call back into the same manager.
+template <typename T, typename LockPolicy = ComponentLockPolicy>
+class ComponentManager
+{
+public:
+    using Id = EntityId;
+
+    // Replaces the component if the entity already has one.
+    template <typename... Args>
+    void add(Id id, Args&&... args)
+    {
+        std::unique_lock lock(mutex_);
+        if (!components_.contains(id)) ++structureVersion_;
+        components_.emplace(id, std::forward<Args>(args)...);
+    }
+
+    void remove(Id id)
+    {
+        std::unique_lock lock(mutex_);
+        if (components_.erase(id)) ++structureVersion_;
+    }
+
+    bool contains(Id id) const
+    {
+        std::shared_lock lock(mutex_);
+        return components_.contains(id);
+    }
+
+    // Copy of the entity's component, or fallback if it has none.
+    T get(Id id, const T& fallback = T{}) const
+    {
+        std::shared_lock lock(mutex_);
+        const T* component = components_.find(id);
+        return component ? *component : fallback;
+    }
+
+    // fn(const T&) or fn(T&) on the entity's component. False if it has none.
+    template <typename Fn>
+    bool read(Id id, Fn&& fn) const
+    {
+        std::shared_lock lock(mutex_);
+        const T* component = components_.find(id);
+        if (!component) return false;
+        fn(*component);
+        return true;
+    }
+
+    template <typename Fn>
+    bool write(Id id, Fn&& fn)
+    {
+        std::unique_lock lock(mutex_);
+        T* component = components_.find(id);
+        if (!component) return false;
+        fn(*component);
+        return true;
+    }
+
+    // fn(Id, T&) over every component, in storage order. fn must not add or
+    // remove components of this manager.
+    template <typename Fn>
+    void forEach(Fn&& fn)
+    {
+        std::unique_lock lock(mutex_);
+        const Span<const Id> ids = components_.ids();
+        const Span<T> values = components_.values();
+        for (std::size_t i = 0; i < values.size(); ++i) fn(ids[i], values[i]);
+    }
+
+    template <typename Fn>
+    void forEach(Fn&& fn) const
+    {
+        std::shared_lock lock(mutex_);
+        const Span<const Id> ids = components_.ids();
+        const Span<const T> values = components_.values();
+        for (std::size_t i = 0; i < values.size(); ++i) fn(ids[i], values[i]);
+    }
+
+    // fn(Id, T&, U&) for every entity that has a component in both managers,
+    // in this manager's storage order. Both stores keep those entities at the
+    // front of their dense arrays in the same order, so the walk is linear
+    // over both with no lookups. Lining them up again costs O(n) and only
+    // happens when an entity was added to or removed from either side since
+    // the last join. Takes this manager's lock, then other's; fn must not
+    // add or remove components of either.
+    template <typename U, typename Fn>
+    void forEachJoined(ComponentManager<U, LockPolicy>& other, Fn&& fn)
+    {
+        std::unique_lock lock(mutex_);
+        std::unique_lock otherLock(other.mutex_);
+        if (joinedWith_ != &other || joinedVersion_ != structureVersion_ || joinedOtherVersion_ != other.structureVersion_) joinWith(other);
+
+        const Span<const Id> ids = components_.ids();
+        const Span<T> values = components_.values();
+        const Span<U> otherValues = other.components_.values();
+        for (std::size_t i = 0; i < joinedCount_; ++i) fn(ids[i], values[i], otherValues[i]);
+    }
+
+    std::size_t size() const
+    {
+        std::shared_lock lock(mutex_);
+        return components_.size();
+    }
+
+    void reserve(std::size_t count)
+    {
+        std::unique_lock lock(mutex_);
+        components_.reserve(count);
+    }
+
+    void clear()
+    {
+        std::unique_lock lock(mutex_);
+        components_.clear();
+        ++structureVersion_;
+    }
+
+private:
+    template <typename, typename> friend class ComponentManager;
+
+    // Moves the entities both managers have to the front of each, in this
+    // manager's order. Positions below count are settled; the others hold
+    // entities other lacks, or that are yet to be visited.
+    template <typename U>
+    void joinWith(ComponentManager<U, LockPolicy>& other)
+    {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < components_.size(); ++i)
+        {
+            const std::uint32_t j = other.components_.indexOf(components_.idAt(i));
+            if (j == SparseSet<U, Id>::Npos) continue;
+
+            components_.swapAt(i, count);
+            other.components_.swapAt(j, count);
+            ++count;
+        }
+
+        // Reordering counts as a change for any other join over either side.
+        ++structureVersion_;
+        ++other.structureVersion_;
+        joinedWith_ = &other;
+        joinedCount_ = count;
+        joinedVersion_ = structureVersion_;
+        joinedOtherVersion_ = other.structureVersion_;
+    }
+
+    mutable LockPolicy mutex_;
+    SparseSet<T, Id> components_;
+
+    // Bumped whenever an entity is added or removed, or the order changes, so
+    // forEachJoined can tell whether the last join still holds.
+    std::uint64_t structureVersion_{};
+    const void* joinedWith_{ nullptr };
+    std::size_t joinedCount_{};
+    std::uint64_t joinedVersion_{};
+    std::uint64_t joinedOtherVersion_{};
+};
@@ -0,0 +1,39 @@
+#include "ComponentRegistry.h"
+#include <mutex>
+#include <stdexcept>
+
+EntityId ComponentRegistry::createEntity()
+{
+    std::unique_lock lock(mutex_);
+    EntityId id;
+    if (!freeIds_.empty())
+    {
+        id = freeIds_.back();
+        freeIds_.pop_back();
+    }
+    else
+    {
+        if (nextId_ >= SparseId::SlotLimit<EntityId>) throw std::length_error("ComponentRegistry: out of entity ids");
+        id = nextId_++;
+        liveIds_.resize(SparseId::slotOf(id) + 1, 0);
+    }
+    liveIds_[SparseId::slotOf(id)] = id;
+    return id;
+}
+
+void ComponentRegistry::destroyEntity(EntityId id)
+{
+    {
+        std::unique_lock lock(mutex_);
+        const std::size_t slot = SparseId::slotOf(id);
+        if (!id || slot >= liveIds_.size() || liveIds_[slot] != id) return;
+
+        liveIds_[slot] = 0;
+        freeIds_.push_back(SparseId::nextGeneration(id));
+    }
+
+    transforms.remove(id);
+    velocities.remove(id);
+    colliders.remove(id);
+    renderables.remove(id);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+#include "ComponentManager.h"
+#include "Components.h"
+
+// Entity ids and the component stores they index. An entity is only an id:
+// what it is follows from the components it has.
+class ComponentRegistry
+{
+public:
+    ComponentRegistry() = default;
+
+    ComponentRegistry(const ComponentRegistry&) = delete;
+    ComponentRegistry& operator=(const ComponentRegistry&) = delete;
+
+    // Ids of destroyed entities are recycled with the next generation (see
+    // SparseId), so the stores' sparse indices stay as small as the peak
+    // entity count and a destroyed id never names another entity. Id 0 is
+    // never handed out.
+    EntityId createEntity();
+    // Removes every component of the entity and recycles its id. Ignores ids
+    // that are not live.
+    void destroyEntity(EntityId id);
+
+    ComponentManager<Transform> transforms;
+    ComponentManager<Velocity> velocities;
+    ComponentManager<Collider> colliders;
+    ComponentManager<Renderable> renderables;
+
+private:
+    ComponentLockPolicy mutex_;
+    // The live id in each slot, or 0 while the slot is free.
+    std::vector<EntityId> liveIds_;
+    std::vector<EntityId> freeIds_;
+    EntityId nextId_{ 1 };
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <SFML/System/Vector2.hpp>
+
+// Components for every simulated object except asteroids, which have their
+// own column store (see AsteroidComponent.h). Each lives in a
+// ComponentManager owned by ComponentRegistry.
+
+struct Transform
+{
+    sf::Vector2f position{};
+    // Degrees, kept in [0, 360).
+    float rotation{};
+    // Where the current tick's movement started, for swept collision tests.
+    sf::Vector2f previousPosition{};
+};
+
+// Moved by Simulation::moveEntities: position += direction * speed * dt, rotation
+// += angularSpeed * dt, after saving position as previousPosition.
+struct Velocity
+{
+    sf::Vector2f direction{};
+    float speed{};
+    float angularSpeed{};
+};
+
+struct Collider
+{
+    float radius{};
+};
+
+// What the presentation layer draws at the entity's Transform. Only a tag:
+// shapes belong to whoever renders (see Game::drawEntities), so the
+// simulation needs no graphics.
+enum class Appearance : std::uint8_t { Bullet, Player, Zone };
+
+struct Renderable
+{
+    Appearance appearance{};
+};
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+// Fixed-capacity pool that may be used from several threads at once.
+//
+// Free objects are kept on a lock-free global stack of slot indices. Worker
+// threads should go through a ThreadCache, which keeps a private free list and
+// only touches the global stack in batches of BatchSize, so the shared cache
+// line is hit once per batch instead of once per acquire/release.
+//
+// Unlike ObjectPool there is no active list to iterate: whoever acquires an
+// object owns it until it is released. As with ObjectPool, releasing an object
+// that is not out (a second release) is ignored: each slot has an in-use flag,
+// and only the release that clears it returns the slot.
+template <typename T, size_t CacheCapacity = 64>
+class ConcurrentObjectPool
+{
+    static_assert(CacheCapacity >= 2, "ThreadCache needs room for at least two objects");
+
+public:
+    static constexpr size_t BatchSize = CacheCapacity / 2;
+    static constexpr size_t ChunkAlignment = alignof(T) > 64 ? alignof(T) : 64;
+
+    class ThreadCache;
+
+    explicit ConcurrentObjectPool(size_t size = 200)
+        : capacity_(size)
+    {
+        if (size >= Empty) throw std::length_error("ConcurrentObjectPool: capacity too large");
+
+        next_ = std::make_unique<std::atomic<std::uint32_t>[]>(size);
+        inUse_ = std::make_unique<std::atomic<bool>[]>(size);
+        storage_.reset(static_cast<unsigned char*>(::operator new(size * sizeof(T), std::align_val_t{ ChunkAlignment })));
+        objects_ = reinterpret_cast<T*>(storage_.get());
+
+        size_t constructed = 0;
+        try {
+            for (; constructed < size; ++constructed) new (objects_ + constructed) T();
+        }
+        catch (...) {
+            while (constructed > 0) objects_[--constructed].~T();
+            throw;
+        }
+
+        for (size_t i = 0; i < size; ++i) {
+            next_[i].store(i + 1 < size ? static_cast<std::uint32_t>(i + 1) : Empty, std::memory_order_relaxed);
+            inUse_[i].store(false, std::memory_order_relaxed);
+        }
+        head_.store(pack(size > 0 ? 0 : Empty, 0), std::memory_order_release);
+    }
+
+    ~ConcurrentObjectPool()
+    {
+        for (size_t i = 0; i < capacity_; ++i) objects_[i].~T();
+    }
+
+    ConcurrentObjectPool(const ConcurrentObjectPool&) = delete;
+    ConcurrentObjectPool& operator=(const ConcurrentObjectPool&) = delete;
+
+    // Uncached access, one CAS on the global stack per call.
+    T* acquire()
+    {
+        std::uint32_t index;
+        return popChain(&index, 1) ? handOut(index) : nullptr;
+    }
+
+    void release(T* obj)
+    {
+        if (!takeBack(obj)) return;
+        const std::uint32_t index = indexOf(obj);
+        pushChain(&index, 1);
+    }
+
+    bool owns(const T* obj) const noexcept
+    {
+        return obj >= objects_ && obj < objects_ + capacity_;
+    }
+
+    size_t capacity() const noexcept { return capacity_; }
+
+private:
+    static constexpr std::uint32_t Empty = static_cast<std::uint32_t>(-1);
+
+    struct ChunkDeleter
+    {
+        void operator()(unsigned char* p) const noexcept { ::operator delete(p, std::align_val_t{ ChunkAlignment }); }
+    };
+
+    // The head packs the top index with a tag that changes on every successful
+    // CAS, which rules out ABA when a popped slot is pushed back in between.
+    static constexpr std::uint64_t pack(std::uint32_t index, std::uint32_t tag) noexcept { return (static_cast<std::uint64_t>(tag) << 32) | index; }
+    static std::uint32_t headIndex(std::uint64_t head) noexcept { return static_cast<std::uint32_t>(head); }
+    static std::uint32_t headTag(std::uint64_t head) noexcept { return static_cast<std::uint32_t>(head >> 32); }
+
+    std::uint32_t indexOf(const T* obj) const noexcept { return static_cast<std::uint32_t>(obj - objects_); }
+
+    // The slot was just popped, so no other thread can see it until it is
+    // released again.
+    T* handOut(std::uint32_t index) noexcept
+    {
+        inUse_[index].store(true, std::memory_order_relaxed);
+        return objects_ + index;
+    }
+
+    // True for the one release that ends obj's use; false for objects of
+    // other pools and for repeated releases.
+    bool takeBack(const T* obj) noexcept
+    {
+        return owns(obj) && inUse_[indexOf(obj)].exchange(false, std::memory_order_acq_rel);
+    }
+
+    // Pops up to maxCount indices with a single CAS. Nodes below the head are
+    // only rewritten after being popped, which changes the tag, so a chain read
+    // under an unchanged head is intact; reads that raced with such a rewrite
+    // are discarded by the failing CAS.
+    size_t popChain(std::uint32_t* out, size_t maxCount)
+    {
+        std::uint64_t head = head_.load(std::memory_order_acquire);
+        for (;;) {
+            std::uint32_t index = headIndex(head);
+            size_t count = 0;
+            while (count < maxCount && index != Empty && index < capacity_) {
+                out[count++] = index;
+                index = next_[index].load(std::memory_order_relaxed);
+            }
+            if (count == 0) return 0;
+
+            if (head_.compare_exchange_weak(head, pack(index, headTag(head) + 1), std::memory_order_acquire, std::memory_order_acquire)) {
+                return count;
+            }
+        }
+    }
+
+    void pushChain(const std::uint32_t* indices, size_t count)
+    {
+        if (count == 0) return;
+
+        for (size_t i = 0; i + 1 < count; ++i) {
+            next_[indices[i]].store(indices[i + 1], std::memory_order_relaxed);
+        }
+
+        const std::uint32_t last = indices[count - 1];
+        std::uint64_t head = head_.load(std::memory_order_relaxed);
+        do {
+            next_[last].store(headIndex(head), std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(head, pack(indices[0], headTag(head) + 1), std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    size_t capacity_;
+    std::unique_ptr<unsigned char, ChunkDeleter> storage_;
+    T* objects_{ nullptr };
+    std::unique_ptr<std::atomic<std::uint32_t>[]> next_;
+    std::unique_ptr<std::atomic<bool>[]> inUse_;
+
+    alignas(64) std::atomic<std::uint64_t> head_{ pack(Empty, 0) };
+    char headPadding_[64 - sizeof(std::atomic<std::uint64_t>)]{};
+};
+
+// Per-thread front end for ConcurrentObjectPool. Not thread-safe itself: each
+// worker owns one. Objects cached here are returned to the pool on destruction.
+template <typename T, size_t CacheCapacity>
+class ConcurrentObjectPool<T, CacheCapacity>::ThreadCache
+{
+public:
+    explicit ThreadCache(ConcurrentObjectPool& pool) noexcept : pool_(pool) {}
+    ~ThreadCache() { flush(count_); }
+
+    ThreadCache(const ThreadCache&) = delete;
+    ThreadCache& operator=(const ThreadCache&) = delete;
+
+    T* acquire()
+    {
+        if (count_ == 0) {
+            count_ = pool_.popChain(items_, BatchSize);
+            if (count_ == 0) return nullptr;
+        }
+        return pool_.handOut(items_[--count_]);
+    }
+
+    void release(T* obj)
+    {
+        if (!pool_.takeBack(obj)) return;
+        if (count_ == CacheCapacity) flush(BatchSize);
+        items_[count_++] = pool_.indexOf(obj);
+    }
+
+    // Returns the oldest cached objects to the global stack, keeping the most
+    // recently released (cache-warm) ones local.
+    void flush(size_t count)
+    {
+        if (count > count_) count = count_;
+        pool_.pushChain(items_, count);
+        for (size_t i = count; i < count_; ++i) items_[i - count] = items_[i];
+        count_ -= count;
+    }
+
+    size_t cachedCount() const noexcept { return count_; }
+
+private:
+    ConcurrentObjectPool& pool_;
+    std::uint32_t items_[CacheCapacity];
+    size_t count_{ 0 };
+};
@@ -1,63 +1,364 @@
 #pragma once
 
-#include <functional>
+#include <cstdint>
+#include <memory>
 #include <mutex>
-#include <typeindex>
-#include <unordered_map>
 #include <vector>
+#include <array>
 #include <atomic>
 #include <algorithm>
+#include <stdexcept>
+#include "InplaceFunction.h"
+#include "MpscQueue.h"
+#include "Span.h"
 
-class EventBus
+// Every event type gets a small dense id the first time it is used, which
+// indexes the bus's channel table directly.
+class EventTypeRegistry
 {
 public:
-    using HandlerId = std::size_t;
+    static constexpr std::size_t MaxEventTypes = 64;
 
     template<typename Event>
-    HandlerId subscribe(std::function<void(const Event&)> handler)
+    static std::size_t id()
+    {
+        static const std::size_t value = allocate();
+        return value;
+    }
+
+private:
+    static std::size_t allocate()
+    {
+        static std::atomic<std::size_t> next{0};
+        const std::size_t value = next++;
+        if (value >= MaxEventTypes) throw std::length_error("EventTypeRegistry: too many event types");
+        return value;
+    }
+};
+
+// Merge hook for queued events: return true after folding next into last to
+// drop next from the queue. Event types opt in with a non-template overload
+// found by argument-dependent lookup (see MouseEvent in InputEvents.h).
+template<typename Event>
+bool coalesceEvent(Event& /*last*/, const Event& /*next*/)
+{
+    return false;
+}
+
+// Bytes of captured state a handler may carry. Enough for a few pointers or a
+// std::function; anything bigger is a compile error rather than an allocation.
+constexpr std::size_t EventHandlerCapacity = 64;
+
+class EventChannelBase
+{
+public:
+    virtual ~EventChannelBase() = default;
+    virtual void drainIngress() = 0;
+    virtual void dispatchQueued() = 0;
+};
+
+using IngressStats = QueueStats;
+
+// Handlers of a single event type, stored with their concrete signature.
+//
+// Handler lists are immutable snapshots. subscribe/unsubscribe build a new
+// snapshot under a writer mutex and publish it with a single atomic store;
+// publish only loads the current snapshot and iterates it, so it takes no
+// lock and never allocates.
+//
+// Replaced snapshots are retired rather than freed, because a publish on
+// another thread, or further up the stack when a handler (un)subscribes, may
+// still be iterating them. Every publish counts itself in while it iterates;
+// subscribe, unsubscribe and dispatchQueued() free the retired snapshots
+// whenever they find that count at zero, so a long run of subscribe/
+// unsubscribe pairs does not pile them up, whether or not events are queued.
+//
+// Besides immediate publish, events can be queued during the tick and
+// delivered in one batch by dispatchQueued(). The queue is double-buffered:
+// events queued while a batch is being delivered go into the next batch. Both
+// buffers keep their capacity, so queueing stops allocating once warmed up.
+// Queueing and dispatch belong to the thread running the tick.
+//
+// Other threads hand events over with post(), which pushes into a bounded
+// lock-free ingress queue; drainIngress() on the tick thread moves them into
+// the regular queue. A full ingress queue drops the event and counts it.
+template<typename Event>
+class EventChannel : public EventChannelBase
+{
+public:
+    using HandlerId = std::size_t;
+    using Handler = InplaceFunction<void(const Event&), EventHandlerCapacity>;
+
+    EventChannel() : current_(std::make_unique<HandlerList>())
+    {
+        snapshot_.store(current_.get(), std::memory_order_release);
+    }
+
+    EventChannel(const EventChannel&) = delete;
+    EventChannel& operator=(const EventChannel&) = delete;
+
+    HandlerId subscribe(Handler handler)
     {
         std::lock_guard<std::mutex> lock(mutex_);
-        auto &vec = handlers_[std::type_index(typeid(Event))];
+        auto next = std::make_unique<HandlerList>(*current_);
         HandlerId id = nextId_++;
-        vec.emplace_back(id, [h = std::move(handler)](const void* e) {
-            h(*static_cast<const Event*>(e));
-        });
+        next->push_back(Entry{ id, std::move(handler) });
+        swapSnapshotLocked(std::move(next));
         return id;
     }
 
-    template<typename Event>
     void unsubscribe(HandlerId id)
     {
         std::lock_guard<std::mutex> lock(mutex_);
-        auto it = handlers_.find(std::type_index(typeid(Event)));
-        if (it == handlers_.end()) return;
-        auto &vec = it->second;
-        vec.erase(std::remove_if(vec.begin(), vec.end(),
-            [id](auto &p) { return p.first == id; }), vec.end());
+        auto found = std::find_if(current_->begin(), current_->end(), [id](const Entry& entry) { return entry.id == id; });
+        if (found == current_->end()) return;
+
+        auto next = std::make_unique<HandlerList>(*current_);
+        next->erase(next->begin() + (found - current_->begin()));
+        swapSnapshotLocked(std::move(next));
+    }
+
+    void publish(const Event& e) const
+    {
+        const PublishScope scope(publishing_);
+        const HandlerList* handlers = snapshot_.load();
+        for (const Entry& entry : *handlers) entry.handler(e);
+    }
+
+    void enqueue(const Event& e)
+    {
+        if (!pending_.empty() && coalesceEvent(pending_.back(), e)) return;
+        pending_.push_back(e);
+    }
+
+    // Delivers everything queued since the previous call, in queue order.
+    void dispatchQueued() override
+    {
+        if (dispatching_) return;
+        dispatching_ = true;
+
+        std::swap(pending_, batch_);
+        pending_.clear();
+        for (const Event& e : batch_) publish(e);
+
+        dispatching_ = false;
+        reclaimRetired();
+    }
+
+    // The batch delivered by the last dispatchQueued(), for systems that would
+    // rather pull events in bulk than receive callbacks. Valid until the next
+    // dispatchQueued().
+    Span<const Event> batch() const noexcept { return Span<const Event>(batch_); }
+
+    std::size_t queuedCount() const noexcept { return pending_.size(); }
+
+    // Any thread. Returns false if the event was dropped.
+    bool post(const Event& e)
+    {
+        return ingress().tryPush(e);
+    }
+
+    void drainIngress() override
+    {
+        auto* queue = ingress_.load(std::memory_order_acquire);
+        if (!queue) return;
+
+        Event e;
+        while (queue->tryPop(e)) enqueue(e);
+    }
+
+    // Takes effect if called before the first post().
+    void setIngressCapacity(std::size_t capacity) noexcept { ingressCapacity_ = capacity; }
+
+    IngressStats ingressStats() const noexcept
+    {
+        auto* queue = ingress_.load(std::memory_order_acquire);
+        if (!queue) return IngressStats{ 0, 0, 0, ingressCapacity_ };
+
+        return queue->stats();
+    }
+
+private:
+    struct Entry
+    {
+        HandlerId id;
+        Handler handler;
+    };
+    using HandlerList = std::vector<Entry>;
+
+    // Counts a publish in for as long as it may hold a snapshot.
+    class PublishScope
+    {
+    public:
+        explicit PublishScope(std::atomic<std::uint32_t>& count) noexcept : count_(count) { count_.fetch_add(1); }
+        ~PublishScope() { count_.fetch_sub(1); }
+
+        PublishScope(const PublishScope&) = delete;
+        PublishScope& operator=(const PublishScope&) = delete;
+
+    private:
+        std::atomic<std::uint32_t>& count_;
+    };
+
+    void swapSnapshotLocked(std::unique_ptr<HandlerList> next)
+    {
+        retired_.push_back(std::move(current_));
+        current_ = std::move(next);
+        snapshot_.store(current_.get());
+        hasRetired_.store(true, std::memory_order_relaxed);
+        reclaimRetiredLocked();
+    }
+
+    void reclaimRetired()
+    {
+        if (!hasRetired_.load(std::memory_order_relaxed)) return;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        reclaimRetiredLocked();
+    }
+
+    // A publish counts itself in before it loads the snapshot, and snapshots
+    // are retired after the new one is stored (all sequentially consistent).
+    // So with no publish counted in, none can still hold a retired snapshot.
+    // A handler that (un)subscribes runs inside a publish, which keeps the
+    // count above zero until it returns.
+    void reclaimRetiredLocked()
+    {
+        if (publishing_.load() != 0) return;
+
+        retired_.clear();
+        hasRetired_.store(false, std::memory_order_relaxed);
+    }
+
+    BoundedMpscQueue<Event>& ingress()
+    {
+        if (auto* queue = ingress_.load(std::memory_order_acquire)) return *queue;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!ingressOwned_)
+        {
+            ingressOwned_ = std::make_unique<BoundedMpscQueue<Event>>(ingressCapacity_);
+            ingress_.store(ingressOwned_.get(), std::memory_order_release);
+        }
+        return *ingressOwned_;
+    }
+
+    std::mutex mutex_;
+    HandlerId nextId_{1};
+    std::atomic<const HandlerList*> snapshot_{nullptr};
+    std::unique_ptr<HandlerList> current_;
+    std::vector<std::unique_ptr<HandlerList>> retired_;
+    std::atomic<bool> hasRetired_{false};
+    mutable std::atomic<std::uint32_t> publishing_{0};
+
+    std::vector<Event> pending_;
+    std::vector<Event> batch_;
+    bool dispatching_{false};
+
+    std::size_t ingressCapacity_{1024};
+    std::atomic<BoundedMpscQueue<Event>*> ingress_{nullptr};
+    std::unique_ptr<BoundedMpscQueue<Event>> ingressOwned_;
+};
+
+// Routes each event type to its EventChannel through a table indexed by the
+// type's dense id: no hashing, and handlers are called through a single
+// non-allocating InplaceFunction with the real event type.
+class EventBus
+{
+public:
+    using HandlerId = std::size_t;
+
+    EventBus() = default;
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    template<typename Event>
+    EventChannel<Event>& channel()
+    {
+        const std::size_t id = EventTypeRegistry::id<Event>();
+        if (auto* existing = channels_[id].load(std::memory_order_acquire))
+        {
+            return *static_cast<EventChannel<Event>*>(existing);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!owned_[id])
+        {
+            owned_[id] = std::make_unique<EventChannel<Event>>();
+            channels_[id].store(owned_[id].get(), std::memory_order_release);
+        }
+        return *static_cast<EventChannel<Event>*>(owned_[id].get());
+    }
+
+    template<typename Event, typename Fn>
+    HandlerId subscribe(Fn&& handler)
+    {
+        return channel<Event>().subscribe(typename EventChannel<Event>::Handler(std::forward<Fn>(handler)));
+    }
+
+    template<typename Event>
+    void unsubscribe(HandlerId id)
+    {
+        if (auto* ch = find<Event>()) ch->unsubscribe(id);
     }
 
     template<typename Event>
     void publish(const Event& e)
     {
-        std::vector<std::pair<HandlerId, std::function<void(const void*)>>> copy;
+        if (auto* ch = find<Event>()) ch->publish(e);
+    }
+
+    // Queues e for the next dispatchQueued() instead of delivering it now.
+    template<typename Event>
+    void enqueue(const Event& e)
+    {
+        channel<Event>().enqueue(e);
+    }
+
+    // Delivers all queued events: channel by channel in event type id order,
+    // and in queue order within a channel.
+    void dispatchQueued()
+    {
+        for (auto& slot : channels_)
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-            auto it = handlers_.find(std::type_index(typeid(Event)));
-            if (it == handlers_.end()) return;
-            copy = it->second; // copy to avoid reentrancy issues
+            if (auto* ch = slot.load(std::memory_order_acquire)) ch->dispatchQueued();
         }
-        for (auto &p : copy) p.second(&e);
+    }
+
+    // Any thread: hands e to the tick thread through the lock-free ingress
+    // queue of its channel. Returns false if the queue was full.
+    template<typename Event>
+    bool post(const Event& e)
+    {
+        return channel<Event>().post(e);
+    }
+
+    template<typename Event>
+    IngressStats ingressStats()
+    {
+        return channel<Event>().ingressStats();
+    }
+
+    // Tick thread, once per tick: moves everything posted from other threads
+    // into the queues, then dispatches the queues.
+    void drain()
+    {
+        for (auto& slot : channels_)
+        {
+            if (auto* ch = slot.load(std::memory_order_acquire)) ch->drainIngress();
+        }
+        dispatchQueued();
     }
 
 private:
+    template<typename Event>
+    EventChannel<Event>* find() const
+    {
+        return static_cast<EventChannel<Event>*>(channels_[EventTypeRegistry::id<Event>()].load(std::memory_order_acquire));
+    }
+
     std::mutex mutex_;
-    std::atomic<HandlerId> nextId_{1};
-    std::unordered_map<std::type_index, std::vector<std::pair<HandlerId, std::function<void(const void*)>>>> handlers_;
+    std::array<std::atomic<EventChannelBase*>, EventTypeRegistry::MaxEventTypes> channels_{};
+    std::array<std::unique_ptr<EventChannelBase>, EventTypeRegistry::MaxEventTypes> owned_{};
 };
 
-// For now, simple header-only global EventBus accessor.
-inline EventBus& GlobalEventBus()
-{
-    static EventBus bus;
-    return bus;
-}
\ No newline at end of file
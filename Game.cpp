@@ -1,92 +1,195 @@
 #include "Game.h"
+#include <SFML/Window/Keyboard.hpp>
 #include "Asteroid.h"
 #include "Bullet.h"
 #include "Button.h"
+#include "ComponentRegistry.h"
 #include "EventBus.h"
 #include "InputEvents.h"
+#include "InputPlayer.h"
+#include "InputRecorder.h"
+#include "World.h"
 #include "AsteroidComponent.h"
 #include <algorithm>
 #include <iostream>
 #include <cmath>
+#include <ctime>
 
-Game::Game() :
+Game::Game(World& world, const GameOptions& options) :
+    options(options),
+    world(world),
     gameState(GameState::MENU),
-    font("Resources/consolas.ttf"),
-    bulletPool(20),
-    asteroidPool(50),
-    shootCooldown(0.25f),
-    asteroidCooldown(1.5f),
-    gameZoneMargin(100.0f),
-    isPlayerInsideZone(false),
-    pointsPerAsteroidLevel(5),
-    timeToCompleteZone(20.0f),
-    pointsPerZoneComplete(50)
+    font("Resources/consolas.ttf")
 {
-    mouseSubId = GlobalEventBus().subscribe<MouseEvent>(
+    initializeShapes();
+
+    keySubId = world.events.subscribe<KeyEvent>(
+        [this](const KeyEvent& ev)
+        {
+            using KE = KeyEvent;
+            const int keyUp = static_cast<int>(sf::Keyboard::Key::Up);
+            const int keyDown = static_cast<int>(sf::Keyboard::Key::Down);
+            const int keyLeft = static_cast<int>(sf::Keyboard::Key::Left);
+            const int keyRight = static_cast<int>(sf::Keyboard::Key::Right);
+            const int keyW = static_cast<int>(sf::Keyboard::Key::W);
+            const int keyS = static_cast<int>(sf::Keyboard::Key::S);
+            const int keyA = static_cast<int>(sf::Keyboard::Key::A);
+            const int keyD = static_cast<int>(sf::Keyboard::Key::D);
+
+            if (ev.action == KE::Action::Press)
+            {
+                if (ev.key == keyUp || ev.key == keyW) { input.thrust = 1.0f; }
+                if (ev.key == keyDown || ev.key == keyS) { input.thrust = -1.0f; }
+                if (ev.key == keyLeft || ev.key == keyA) { input.turn = -1.0f; }
+                if (ev.key == keyRight || ev.key == keyD) { input.turn = 1.0f; }
+            }
+            else // Release
+            {
+                if (ev.key == keyUp || ev.key == keyW) { if (input.thrust > 0.0f) input.thrust = 0.0f; }
+                if (ev.key == keyDown || ev.key == keyS) { if (input.thrust < 0.0f) input.thrust = 0.0f; }
+                if (ev.key == keyLeft || ev.key == keyA) { if (input.turn < 0.0f) input.turn = 0.0f; }
+                if (ev.key == keyRight || ev.key == keyD) { if (input.turn > 0.0f) input.turn = 0.0f; }
+            }
+        });
+
+    mouseSubId = world.events.subscribe<MouseEvent>(
         [this](const MouseEvent& ev)
         {
+            mousePosition = sf::Vector2f(ev.x, ev.y);
+
             if (gameState != GameState::PLAYING) return;
 
             if (ev.action == MouseEvent::Action::ButtonPress &&
                 ev.button == static_cast<int>(sf::Mouse::Button::Left))
             {
-                tryShoot();
+                input.fire = true;
             }
         });
 }
 
 Game::~Game()
 {
-    if (mouseSubId) GlobalEventBus().unsubscribe<MouseEvent>(mouseSubId);
+    if (keySubId) world.events.unsubscribe<KeyEvent>(keySubId);
+    if (mouseSubId) world.events.unsubscribe<MouseEvent>(mouseSubId);
 }
 
 void Game::run()
 {
-    sf::Clock deltaTimeClock;
+    sf::Clock frameClock;
+    float accumulator = 0.0f;
 
     window.create(sf::VideoMode::getDesktopMode(), "Spacewar Test");
+    simulation = std::make_unique<Simulation>(world, window.getSize());
 
     initializeUI();
     initializeTexts();
 
-    while (window.isOpen())
+    if (!options.recordPath.empty())
     {
-        sf::Time deltaTime = deltaTimeClock.restart();
-
-        handleInput();
-        update(deltaTime.asSeconds());
-        render();
+        const sf::Vector2u arenaSize = simulation->getArenaSize();
+        recorder = std::make_unique<InputRecorder>(world.events, options.recordPath, arenaSize.x, arenaSize.y, simulation->getTimeStep(),
+            options.asteroidCollisions);
+        if (!recorder->isOpen())
+        {
+            std::cerr << "Cannot record to " << options.recordPath << std::endl;
+            recorder.reset();
+        }
     }
-}
 
-void Game::handleInput()
-{
-    while (const std::optional event = window.pollEvent())
+    if (!options.replayPath.empty())
     {
-        if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>())
+        replay = std::make_unique<InputPlayer>(options.replayPath, options.replaySession);
+        if (replay->isOpen())
         {
-            KeyEvent ke{ static_cast<int>(keyPressed->scancode), KeyEvent::Action::Press };
-            GlobalEventBus().publish<KeyEvent>(ke);
+            restart();
         }
-        if (const auto* keyReleased = event->getIf<sf::Event::KeyReleased>())
+        else
         {
-            KeyEvent ke{ static_cast<int>(keyReleased->scancode), KeyEvent::Action::Release };
-            GlobalEventBus().publish<KeyEvent>(ke);
+            std::cerr << "Cannot replay " << options.replayPath << ": not an input log or no session " << options.replaySession << std::endl;
+            replay.reset();
         }
-        if (const auto* mouseMoved = event->getIf<sf::Event::MouseMoved>())
+    }
+
+    while (window.isOpen())
+    {
+        accumulator += frameClock.restart().asSeconds();
+
+        handleInput();
+
+        if (replay && options.replayFast && gameState == GameState::PLAYING)
         {
-            MouseEvent me{ static_cast<float>(mouseMoved->position.x), static_cast<float>(mouseMoved->position.y), -1, MouseEvent::Action::Move };
-            GlobalEventBus().publish<MouseEvent>(me);
+            for (int i = 0; i < FastReplayStepsPerFrame && gameState == GameState::PLAYING; ++i)
+            {
+                step();
+            }
+            accumulator = 0.0f;
         }
-        if (const auto* mousePressed = event->getIf<sf::Event::MouseButtonPressed>())
+        else
+        {
+            for (int i = 0; i < MaxStepsPerFrame && accumulator >= simulation->getTimeStep(); ++i)
+            {
+                step();
+                accumulator -= simulation->getTimeStep();
+            }
+
+            // Drop time we could not catch up on rather than spiralling.
+            accumulator = std::min(accumulator, simulation->getTimeStep());
+        }
+
+        render();
+    }
+}
+
+// One simulation tick: input stamped with this tick is delivered and folded
+// into the InputState, then the simulation advances by one fixed step.
+//
+// Nothing is delivered while paused. Input from the pause stays queued and
+// reaches subscribers, the recorder among them, on the first tick after it,
+// which is also where a replay, which never pauses, delivers it.
+void Game::step()
+{
+    if (gameState == GameState::PAUSED) return;
+
+    if (recorder) recorder->setTick(simulation->getTick());
+    if (replay) replay->enqueueUpTo(simulation->getTick(), world.events);
+
+    world.events.drain();
+
+    // Last position seen on the bus rather than the live cursor, so replays
+    // aim where the recorded session did. Recorded positions are already in
+    // the recording's arena, whatever this window's size.
+    input.aim = replay ? mousePosition : window.mapPixelToCoords(sf::Vector2i(mousePosition));
+
+    if (gameState == GameState::PLAYING)
+    {
+        simulation->step(input);
+
+        switch (simulation->getState())
         {
-            MouseEvent me{ static_cast<float>(mousePressed->position.x), static_cast<float>(mousePressed->position.y), static_cast<int>(mousePressed->button), MouseEvent::Action::ButtonPress };
-            GlobalEventBus().publish<MouseEvent>(me);
+        case Simulation::State::Lost:
+            gameState = GameState::GAME_OVER;
+            finishGame();
+            break;
+        case Simulation::State::Won:
+            gameState = GameState::WIN;
+            finishGame();
+            break;
+        default:
+            break;
         }
-        if (const auto* mouseReleased = event->getIf<sf::Event::MouseButtonReleased>())
+    }
+
+    input.fire = false;
+}
+
+void Game::handleInput()
+{
+    while (const std::optional event = window.pollEvent())
+    {
+        // While replaying, the bus only sees recorded input.
+        if (!replay)
         {
-            MouseEvent me{ static_cast<float>(mouseReleased->position.x), static_cast<float>(mouseReleased->position.y), static_cast<int>(mouseReleased->button), MouseEvent::Action::ButtonRelease };
-            GlobalEventBus().publish<MouseEvent>(me);
+            forwardInputEvent(*event);
         }
 
         if (event->is<sf::Event::Closed>())
@@ -119,6 +222,37 @@ void Game::handleInput()
     }
 }
 
+// Translates window input into bus events. They are queued, not published, and
+// reach subscribers on the next simulation tick.
+void Game::forwardInputEvent(const sf::Event& event)
+{
+    if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>())
+    {
+        KeyEvent ke{ static_cast<int>(keyPressed->scancode), KeyEvent::Action::Press };
+        world.events.enqueue<KeyEvent>(ke);
+    }
+    if (const auto* keyReleased = event.getIf<sf::Event::KeyReleased>())
+    {
+        KeyEvent ke{ static_cast<int>(keyReleased->scancode), KeyEvent::Action::Release };
+        world.events.enqueue<KeyEvent>(ke);
+    }
+    if (const auto* mouseMoved = event.getIf<sf::Event::MouseMoved>())
+    {
+        MouseEvent me{ static_cast<float>(mouseMoved->position.x), static_cast<float>(mouseMoved->position.y), -1, MouseEvent::Action::Move };
+        world.events.enqueue<MouseEvent>(me);
+    }
+    if (const auto* mousePressed = event.getIf<sf::Event::MouseButtonPressed>())
+    {
+        MouseEvent me{ static_cast<float>(mousePressed->position.x), static_cast<float>(mousePressed->position.y), static_cast<int>(mousePressed->button), MouseEvent::Action::ButtonPress };
+        world.events.enqueue<MouseEvent>(me);
+    }
+    if (const auto* mouseReleased = event.getIf<sf::Event::MouseButtonReleased>())
+    {
+        MouseEvent me{ static_cast<float>(mouseReleased->position.x), static_cast<float>(mouseReleased->position.y), static_cast<int>(mouseReleased->button), MouseEvent::Action::ButtonRelease };
+        world.events.enqueue<MouseEvent>(me);
+    }
+}
+
 void Game::handleMenuInput(const sf::Event& event)
 {
     startButton->update(sf::Vector2f(sf::Mouse::getPosition(window)), event);
@@ -144,57 +278,6 @@ void Game::handlePausedInput(const sf::Event& event)
     }
 }
 
-void Game::update(float deltaTime)
-{
-    if (gameState == GameState::PLAYING)
-    {
-        for (Entity* entity : entities)
-        {
-            if (!entity) continue;
-
-            entity->update(deltaTime);
-        }
-
-        isPlayerInsideZone = player.intersects(zone);
-        if (isPlayerInsideZone)
-        {
-            if (!zoneTimer.isRunning())
-            {
-                zoneTimer.restart();
-            }
-
-            if (zoneTimer.getElapsedTime().asSeconds() >= timeToCompleteZone)
-            {
-                ++zonesCompleted;
-                score += pointsPerZoneComplete;
-                spawnZone();
-            }
-        }
-        else
-        {
-            if (zoneTimer.isRunning())
-            {
-                zoneTimer.stop();
-            }
-        }
-
-        constrainPlayerMovement();
-
-        checkCollisions();
-        trySpawnAsteroid();
-    }
-
-    const std::string playtimeSecondsString = "Time: " + std::to_string(static_cast<int>(playtimeTimer.getElapsedTime().asSeconds()));
-    playtimeText->setString(playtimeSecondsString);
-
-    const std::string scoreString = "Score: " + std::to_string(score);
-    scoreText->setString(scoreString);
-    scoreText->setOrigin(sf::Vector2f(scoreText->getLocalBounds().size.x + 10.0f, 0.0f));
-
-    const std::string remainintTimeInZoneText = std::to_string(static_cast<int>(1 + timeToCompleteZone - zoneTimer.getElapsedTime().asSeconds()));
-    timeInZoneText->setString(remainintTimeInZoneText);
-}
-
 void Game::render()
 {
     window.clear();
@@ -208,11 +291,10 @@ void Game::render()
     case GameState::PAUSED:
         window.draw(*pauseText.get());
     case GameState::PLAYING:
-        for (Entity* entity : entities)
-        {
-            window.draw(*entity);
-        }
-        if (isPlayerInsideZone)
+        updateTexts();
+        drawEntities();
+        drawAsteroids();
+        if (simulation->getIsPlayerInsideZone())
         {
             window.draw(*timeInZoneText.get());
         }
@@ -233,134 +315,93 @@ void Game::render()
     window.display();
 }
 
-void Game::checkCollisions()
+// Asteroids are not in the registry; see drawAsteroids.
+void Game::drawEntities()
 {
-    for (Bullet* bullet : bulletPool.getActiveObjects())
+    ComponentRegistry& registry = world.components;
+    registry.renderables.forEach([&](EntityId id, const Renderable& renderable)
     {
-        if (!bullet) continue;
+        const Transform transform = registry.transforms.get(id);
 
-        if (isEntityOutOfBounds(*bullet))
-        {
-            bulletPool.release(bullet);
-            entities.remove(bullet);
-            continue;
-        }
-
-        const sf::Vector2f bulletPos = bullet->getPosition();
-        const float bulletRadius = bullet->getCollisionRadius();
-        bool bulletConsumed = false;
+        sf::RenderStates states;
+        states.transform.translate(transform.position);
+        states.transform.rotate(sf::degrees(transform.rotation));
 
-        for (Asteroid* asteroid : asteroidPool.getActiveObjects())
+        switch (renderable.appearance)
         {
-            if (!asteroid) continue;
-
-            float asteroidRadius = AsteroidComponentManager::instance().getRadiusByOwner(asteroid);
-            if (asteroidRadius <= 0.0f) continue;
-
-            const sf::Vector2f asteroidPos = asteroid->getPosition();
-            const float dx = bulletPos.x - asteroidPos.x;
-            const float dy = bulletPos.y - asteroidPos.y;
-            const float distSq = dx * dx + dy * dy;
-            const float minDist = bulletRadius + asteroidRadius;
-
-            if (distSq <= (minDist * minDist))
-            {
-                score += pointsPerAsteroidLevel * asteroid->getLevel();
-
-                bulletPool.release(bullet);
-                entities.remove(bullet);
-
-                splitAsteroid(asteroid);
-                bulletConsumed = true;
-                break;
-            }
+        case Appearance::Bullet:
+            window.draw(bulletShape, states);
+            break;
+        case Appearance::Player:
+            window.draw(playerShape, states);
+            window.draw(playerHeadingShape, states);
+            break;
+        case Appearance::Zone:
+            window.draw(zoneShape, states);
+            break;
         }
+    });
+}
 
-        if (bulletConsumed) continue;
-    }
-
-    const sf::Vector2f playerPos = player.getPosition();
-    const float playerRadius = player.getCollisionRadius();
-
-    for (Asteroid* asteroid : asteroidPool.getActiveObjects())
+// One shape for every asteroid, resized to each one's radius.
+void Game::drawAsteroids()
+{
+    for (Asteroid* asteroid : world.asteroidPool.getActiveObjects())
     {
-        if (!asteroid) continue;
+        if (!asteroid->getComponentId()) continue;
 
-        if (isEntityOutOfBounds(*asteroid))
-        {
-            asteroidPool.release(asteroid);
-            entities.remove(asteroid);
-            continue;
-        }
-
-        float asteroidRadius = AsteroidComponentManager::instance().getRadiusByOwner(asteroid);
-        if (asteroidRadius <= 0.0f) continue;
+        const AsteroidRenderState renderState = world.asteroids.getRenderState(asteroid->getComponentId());
+        asteroidShape.setRadius(renderState.radius);
+        asteroidShape.setOrigin({ renderState.radius, renderState.radius });
 
-        const sf::Vector2f asteroidPos = asteroid->getPosition();
-        const float dx = playerPos.x - asteroidPos.x;
-        const float dy = playerPos.y - asteroidPos.y;
-        const float distSq = dx * dx + dy * dy;
-        const float minDist = playerRadius + asteroidRadius;
-
-        if (distSq <= (minDist * minDist))
-        {
-            gameState = GameState::GAME_OVER;
-            finishGame();
-            break;
-        }
+        sf::RenderStates states;
+        states.transform.translate(renderState.position);
+        states.transform.rotate(sf::degrees(renderState.rotation));
+        window.draw(asteroidShape, states);
     }
 }
 
 void Game::restart()
 {
-    gameState = GameState::PLAYING;
-    zonesCompleted = 0;
-    score = 0;
-    player.setSpeed(0.0f);
-    player.setRotation(sf::Angle());
-    player.setPosition(sf::Vector2f(window.getSize()) / 2.0f);
-
-    entities.clear();
-    entities.push_back(&player);
-    entities.push_back(&zone);
-
-    for (Bullet* bullet : bulletPool.getActiveObjects())
+    // A replay reuses the recorded seed; asteroid spawns and splits draw from
+    // world.random, so this and the recorded input fully determine the session.
+    // The arena, time step and asteroid collisions shape the session as much
+    // as the seed, so a replay takes them from the log and the view shows
+    // that arena scaled to this window.
+    std::uint32_t seed = static_cast<std::uint32_t>(std::time(nullptr));
+    if (replay)
     {
-        entities.remove(bullet);
+        seed = replay->getSeed();
+        useSimulation({ replay->getArenaWidth(), replay->getArenaHeight() }, replay->getTimeStep());
+        simulation->setAsteroidCollisions(replay->getAsteroidCollisions());
     }
-
-    for (Asteroid* asteroid : asteroidPool.getActiveObjects())
+    else
     {
-        asteroidPool.release(asteroid);
+        useSimulation(window.getSize(), Simulation::DefaultTimeStep);
+        simulation->setAsteroidCollisions(options.asteroidCollisions);
+        if (recorder) recorder->beginSession(seed);
     }
+    window.setView(sf::View(sf::FloatRect({ 0.0f, 0.0f }, sf::Vector2f(simulation->getArenaSize()))));
 
-    shootTimer.restart();
-    asteroidTimer.restart();
-    playtimeTimer.restart();
+    gameState = GameState::PLAYING;
+    simulation->start(seed);
+}
 
-    spawnZone();
+void Game::useSimulation(const sf::Vector2u& arenaSize, float timeStep)
+{
+    if (simulation->getArenaSize() == arenaSize && simulation->getTimeStep() == timeStep) return;
+    simulation = std::make_unique<Simulation>(world, arenaSize, timeStep);
 }
 
+// The simulation is not stepped while paused, so its timers stop with it.
 void Game::pause()
 {
     gameState = GameState::PAUSED;
-    playtimeTimer.stop();
-
-    if (zoneTimer.isRunning())
-    {
-        zoneTimer.stop();
-    }
 }
 
 void Game::resume()
 {
     gameState = GameState::PLAYING;
-    playtimeTimer.start();
-
-    if (isPlayerInsideZone)
-    {
-        zoneTimer.start();
-    }
 }
 
 void Game::finishGame()
@@ -375,186 +416,18 @@ void Game::finishGame()
         endGameText = "You died!";
     }
 
-    entities.clear();
-
-    for (Bullet* bullet : bulletPool.getActiveObjects())
-    {
-        entities.remove(bullet);
-    }
-
-    for (Asteroid* asteroid : asteroidPool.getActiveObjects())
-    {
-        asteroidPool.release(asteroid);
-    }
+    if (recorder) recorder->endSession();
+    replay.reset();
+    window.setView(window.getDefaultView());
 
-    endGameText += "\nTotal time played: " + std::to_string(static_cast<int>(playtimeTimer.getElapsedTime().asSeconds())) + " seconds";
-    endGameText += "\nTotal Score: " + std::to_string(score) + " points";
+    endGameText += "\nTotal time played: " + std::to_string(static_cast<int>(simulation->getPlaytime())) + " seconds";
+    endGameText += "\nTotal Score: " + std::to_string(simulation->getScore()) + " points";
 
     resultsText->setString(endGameText);
     resultsText->setOrigin(resultsText->getLocalBounds().getCenter());
     resultsText->setPosition(sf::Vector2f(window.getSize().x / 2, window.getSize().y / 3));
 }
 
-void Game::tryShoot()
-{
-    if (shootTimer.getElapsedTime().asSeconds() <= shootCooldown) return;
-
-    Bullet* bullet = bulletPool.acquire();
-    if (bullet)
-    {
-        sf::Vector2f direction = getDirectionToMouse(player.getPosition());
-        bullet->setPosition(player.getPosition());
-        bullet->setDirection(direction);
-        entities.push_back(bullet);
-    }
-
-    shootTimer.restart();
-}
-
-void Game::trySpawnAsteroid()
-{
-    if (asteroidTimer.getElapsedTime().asSeconds() <= asteroidCooldown) return;
-
-    Asteroid* asteroid = asteroidPool.acquire();
-    if (!asteroid) return;
-
-    sf::Vector2u windowSize = window.getSize();
-
-    float x, y;
-    float spawnMargin = 50.0f;
-    int side = rand() % 4;
-
-    switch (side) {
-    case 0: // Up
-        x = rand() % windowSize.x;
-        y = -spawnMargin;
-        break;
-    case 1: // Down
-        x = rand() % windowSize.x;
-        y = windowSize.y + spawnMargin;
-        break;
-    case 2: // Left
-        x = -spawnMargin;
-        y = rand() % windowSize.y;
-        break;
-    case 3: // Right
-        x = windowSize.x + spawnMargin;
-        y = rand() % windowSize.y;
-        break;
-    default:
-        x = 0;
-        y = 0;
-        break;
-    }
-
-    sf::Vector2f center;
-    if (isPlayerInsideZone)
-    {
-        center = player.getPosition();
-    }
-    else
-    {
-        center = sf::Vector2f(windowSize.x / 2.0f + rand() % 500 - 250, windowSize.y / 2.0f + rand() % 500 - 250);
-    }
-
-    sf::Vector2f direction = center - sf::Vector2f(x, y);
-    normalizeVector(direction);
-
-    asteroid->setPosition({ x, y });
-
-    AsteroidComponentManager::instance().setDirectionByOwner(asteroid, direction);
-    AsteroidComponentManager::instance().setLevelByOwner(asteroid, rand() % 3 + 1);
-    float speed = AsteroidComponentManager::instance().getDefaultSpeedByOwner(asteroid) + (rand() % 200 - 100);
-    AsteroidComponentManager::instance().setSpeedByOwner(asteroid, speed);
-
-    entities.push_back(asteroid);
-
-    asteroidTimer.restart();
-}
-
-void Game::splitAsteroid(Asteroid* asteroid)
-{
-    if (!asteroid) return;
-
-    int currentLevel = AsteroidComponentManager::instance().getLevelByOwner(asteroid);
-    if (currentLevel <= 1)
-    {
-        asteroidPool.release(asteroid);
-        entities.remove(asteroid);
-        return;
-    }
-
-    AsteroidComponentManager::instance().decreaseLevel(AsteroidComponentManager::instance().getIdForOwner(asteroid));
-
-    Asteroid* newAsteroid = asteroidPool.acquire();
-    if (!newAsteroid) return;
-
-    int newLevel = AsteroidComponentManager::instance().getLevelByOwner(asteroid);
-    AsteroidComponentManager::instance().setLevelByOwner(newAsteroid, newLevel);
-
-    newAsteroid->setPosition(asteroid->getPosition());
-
-    auto dirId = AsteroidComponentManager::instance().getIdForOwner(asteroid);
-    sf::Vector2f origDir = AsteroidComponentManager::instance().getDirection(dirId);
-    sf::Vector2f dirA = origDir;
-    sf::Vector2f dirB = origDir;
-
-    float angleA = static_cast<float>(rand() % 50 - 25);
-    float angleB = static_cast<float>(rand() % 50 - 25);
-    dirA = dirA;
-    dirB = dirB;
-
-    auto rotateVec = [](sf::Vector2f v, float degrees)->sf::Vector2f {
-        const float rad = degrees * 3.14159265358979323846f / 180.0f;
-        float c = std::cos(rad), s = std::sin(rad);
-        return sf::Vector2f(v.x * c - v.y * s, v.x * s + v.y * c);
-    };
-
-    sf::Vector2f newDirA = rotateVec(origDir, angleA);
-    sf::Vector2f newDirB = rotateVec(origDir, angleB);
-
-    AsteroidComponentManager::instance().setDirectionByOwner(newAsteroid, newDirA);
-    AsteroidComponentManager::instance().setDirectionByOwner(asteroid, newDirB);
-
-    float speedA = AsteroidComponentManager::instance().getDefaultSpeedByOwner(newAsteroid) + (rand() % 200 - 100);
-    float speedB = AsteroidComponentManager::instance().getDefaultSpeedByOwner(asteroid) + (rand() % 200 - 100);
-
-    AsteroidComponentManager::instance().setSpeedByOwner(newAsteroid, speedA);
-    AsteroidComponentManager::instance().setSpeedByOwner(asteroid, speedB);
-
-    entities.push_back(newAsteroid);
-}
-
-void Game::spawnZone()
-{
-    if (zonesCompleted > 2)
-    {
-        gameState = GameState::WIN;
-        finishGame();
-        return;
-    }
-
-    sf::Vector2u windowSize = window.getSize();
-    sf::Vector2u zoneLocation;
-    zoneLocation.x = windowSize.x / 4 * (zonesCompleted + 1);
-    zoneLocation.y = windowSize.y / 2;
-
-    zone.setPosition(sf::Vector2f(zoneLocation));
-}
-
-float Game::isEntityOutOfBounds(const Entity& entity)
-{
-    sf::Vector2f entityPosition = entity.getPosition();
-
-    float left = 0 - gameZoneMargin;
-    float right = window.getSize().x + gameZoneMargin;
-    float top = 0 - gameZoneMargin;
-    float bottom = window.getSize().y + gameZoneMargin;
-
-    bool outOfBounds = (entityPosition.x <= left || entityPosition.x >= right || entityPosition.y <= top || entityPosition.y >= bottom);
-    return outOfBounds;
-}
-
 void Game::initializeUI()
 {
     const sf::Vector2f screenCenter = sf::Vector2f(window.getSize()) / 2.0f;
@@ -582,31 +455,45 @@ void Game::initializeTexts()
     resultsText = std::make_unique<sf::Text>(font, "");
 }
 
-void Game::constrainPlayerMovement()
-{
-    sf::Vector2f playerCorrectedPosition;
-    playerCorrectedPosition.x = std::clamp(player.getPosition().x, player.getRadius(), static_cast<float>(window.getSize().x) - player.getRadius());
-    playerCorrectedPosition.y = std::clamp(player.getPosition().y, player.getRadius(), static_cast<float>(window.getSize().y) - player.getRadius());
-    player.setPosition(playerCorrectedPosition);
-}
-
-void Game::normalizeVector(sf::Vector2f& vector)
+void Game::initializeShapes()
 {
-    float length = std::sqrt(vector.x * vector.x + vector.y * vector.y);
-    if (length > 0) {
-        vector.x /= length;
-        vector.y /= length;
-    }
+    bulletShape.setFillColor(sf::Color::Red);
+    bulletShape.setRadius(Bullet::Radius);
+    bulletShape.setPointCount(5);
+    bulletShape.setOrigin({ Bullet::Radius, Bullet::Radius });
+
+    playerShape.setFillColor(sf::Color::White);
+    playerShape.setRadius(Player::Radius);
+    playerShape.setPointCount(3);
+    playerShape.setOrigin({ Player::Radius, Player::Radius });
+
+    playerHeadingShape.setFillColor(sf::Color::Black);
+    playerHeadingShape.setRadius(10.0f);
+    playerHeadingShape.setPointCount(3);
+    playerHeadingShape.setOrigin({ 10.0f, 17.0f });
+
+    zoneShape.setFillColor(sf::Color::Transparent);
+    zoneShape.setOutlineColor(sf::Color::White);
+    zoneShape.setOutlineThickness(2.0f);
+    zoneShape.setRadius(Zone::Radius);
+    zoneShape.setPointCount(25);
+    zoneShape.setOrigin({ Zone::Radius, Zone::Radius });
+
+    asteroidShape.setFillColor(sf::Color(50, 50, 50));
+    asteroidShape.setOutlineColor(sf::Color(100, 100, 100));
+    asteroidShape.setOutlineThickness(4.0f);
+    asteroidShape.setPointCount(8);
 }
 
-sf::Vector2f Game::getDirectionToMouse(const sf::Vector2f& playerPosition)
+void Game::updateTexts()
 {
-    sf::Vector2i mouseScreenPosition = sf::Mouse::getPosition(window);
-    sf::Vector2f mouseWorldPosition = window.mapPixelToCoords(mouseScreenPosition);
-
-    sf::Vector2f direction = mouseWorldPosition - playerPosition;
+    const std::string playtimeSecondsString = "Time: " + std::to_string(static_cast<int>(simulation->getPlaytime()));
+    playtimeText->setString(playtimeSecondsString);
 
-    normalizeVector(direction);
+    const std::string scoreString = "Score: " + std::to_string(simulation->getScore());
+    scoreText->setString(scoreString);
+    scoreText->setOrigin(sf::Vector2f(scoreText->getLocalBounds().size.x + 10.0f, 0.0f));
 
-    return direction;
+    const std::string remainintTimeInZoneText = std::to_string(static_cast<int>(1 + simulation->getZoneTimeRemaining()));
+    timeInZoneText->setString(remainintTimeInZoneText);
 }
@@ -1,51 +1,61 @@
 #pragma once
 
+#include <SFML/Graphics/CircleShape.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
-#include <list>
-#include "ObjectPool.h"
-#include "Player.h"
-#include "Zone.h"
+#include <cstdint>
+#include <string>
 #include "Button.h"
 #include "EventBus.h"
+#include "Simulation.h"
 
-class Entity;
-class Bullet;
-class Asteroid;
+class World;
+class InputRecorder;
+class InputPlayer;
+
+struct GameOptions
+{
+	// Input of every session started is written here (see InputRecorder).
+	std::string recordPath;
+	// Log replayed on startup instead of taking live input.
+	std::string replayPath;
+	// Which of the log's sessions to replay, counting from 0.
+	std::size_t replaySession{ 0 };
+	// Simulate the replay as fast as possible instead of in real time.
+	bool replayFast{ false };
+	// Asteroids collide with each other (see Simulation::setAsteroidCollisions).
+	// A replay takes this from the log instead.
+	bool asteroidCollisions{ false };
+};
 
 class Game
 {
 public:
-	Game();
+	explicit Game(World& world, const GameOptions& options = GameOptions{});
 	~Game();
 	void run();
 
 private:
+	GameOptions options;
+	World& world;
+
 	enum class GameState { MENU, PLAYING, PAUSED, GAME_OVER, WIN };
 	GameState gameState;
 	sf::RenderWindow window;
 	sf::Font font;
 
-	Player player;
-	ObjectPool<Bullet> bulletPool;
-	ObjectPool<Asteroid> asteroidPool;
-	std::list<Entity*> entities;
-	
-	Zone zone;
-	sf::Clock zoneTimer;
-	sf::Clock playtimeTimer;
-	float timeToCompleteZone;
-	int zonesCompleted{};
-	bool isPlayerInsideZone;
-
-	float shootCooldown;
-	sf::Clock shootTimer;
-	float asteroidCooldown;
-	sf::Clock asteroidTimer;
+	// Created once the window exists: the arena is the window, except in a
+	// replay, which takes the recording's arena and time step (see restart).
+	std::unique_ptr<Simulation> simulation;
+	// Built from bus events as they are drained, consumed by the next step.
+	InputState input;
+	sf::Vector2f mousePosition;
 
-	float gameZoneMargin;
-	int pointsPerAsteroidLevel;
-	int pointsPerZoneComplete;
-	int score{};
+	// The simulation has no graphics; how each Appearance looks lives here.
+	sf::CircleShape bulletShape;
+	sf::CircleShape playerShape;
+	sf::CircleShape playerHeadingShape;
+	sf::CircleShape zoneShape;
+	sf::CircleShape asteroidShape;
 
 	std::unique_ptr<Button> startButton;
 	std::unique_ptr<Button> exitButton;
@@ -57,31 +67,34 @@ private:
 	std::unique_ptr<sf::Text> playtimeText;
 	std::unique_ptr<sf::Text> resultsText;
 
+	// The simulation always advances in steps of its fixed time step, so a
+	// session replays identically regardless of frame rate.
+	static constexpr int MaxStepsPerFrame = 5;
+	static constexpr int FastReplayStepsPerFrame = 100;
+
+	std::unique_ptr<InputRecorder> recorder;
+	std::unique_ptr<InputPlayer> replay;
+
+	void step();
 	void handleInput();
+	void forwardInputEvent(const sf::Event& event);
 	void handleMenuInput(const sf::Event& event);
 	void handleGameInput(const sf::Event& event);
 	void handlePausedInput(const sf::Event& event);
-	void update(float deltaTime);
 	void render();
-	void checkCollisions();
+	void drawEntities();
+	void drawAsteroids();
 	void restart();
+	void useSimulation(const sf::Vector2u& arenaSize, float timeStep);
 	void pause();
 	void resume();
 	void finishGame();
 
-	void tryShoot();
-	void trySpawnAsteroid();
-	void splitAsteroid(Asteroid* asteroid);
-	void spawnZone();
-	float isEntityOutOfBounds(const Entity& entity);
-
 	void initializeUI();
 	void initializeTexts();
+	void initializeShapes();
+	void updateTexts();
 
-	void constrainPlayerMovement();
-
-	void normalizeVector(sf::Vector2f& vector);
-	sf::Vector2f getDirectionToMouse(const sf::Vector2f& playerPosition);
-
+	EventBus::HandlerId keySubId{0};
 	EventBus::HandlerId mouseSubId{0};
 };
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template<typename Signature, std::size_t Capacity = 4 * sizeof(void*)>
+class InplaceFunction;
+
+// std::function replacement that stores the callable inside the object and
+// never allocates. A callable bigger than Capacity is a compile error, not a
+// silent heap fallback: raise Capacity at the use site instead.
+template<typename R, typename... Args, std::size_t Capacity>
+class InplaceFunction<R(Args...), Capacity>
+{
+public:
+    static constexpr std::size_t capacity = Capacity;
+
+    InplaceFunction() noexcept = default;
+    InplaceFunction(std::nullptr_t) noexcept {}
+
+    template<typename F, typename Fn = std::decay_t<F>,
+        typename = std::enable_if_t<!std::is_same_v<Fn, InplaceFunction> && std::is_invocable_r_v<R, Fn&, Args...>>>
+    InplaceFunction(F&& f)
+    {
+        static_assert(sizeof(Fn) <= Capacity, "InplaceFunction: callable does not fit, raise Capacity");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "InplaceFunction: callable is over-aligned");
+        static_assert(std::is_copy_constructible_v<Fn>, "InplaceFunction: callable must be copyable");
+        static_assert(std::is_nothrow_move_constructible_v<Fn>, "InplaceFunction: callable must be nothrow movable");
+
+        new (storage_) Fn(std::forward<F>(f));
+        invoke_ = &invokeImpl<Fn>;
+        manage_ = &manageImpl<Fn>;
+    }
+
+    InplaceFunction(const InplaceFunction& other)
+    {
+        if (other.manage_) other.manage_(Op::Copy, storage_, other.storage_);
+        invoke_ = other.invoke_;
+        manage_ = other.manage_;
+    }
+
+    InplaceFunction(InplaceFunction&& other) noexcept
+    {
+        if (other.manage_) other.manage_(Op::Move, storage_, other.storage_);
+        invoke_ = other.invoke_;
+        manage_ = other.manage_;
+    }
+
+    InplaceFunction& operator=(const InplaceFunction& other)
+    {
+        if (this != &other)
+        {
+            InplaceFunction copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(InplaceFunction&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            if (other.manage_) other.manage_(Op::Move, storage_, other.storage_);
+            invoke_ = other.invoke_;
+            manage_ = other.manage_;
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(std::nullptr_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    ~InplaceFunction() { reset(); }
+
+    R operator()(Args... args) const
+    {
+        assert(invoke_ && "InplaceFunction: called while empty");
+        return invoke_(storage_, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept { return invoke_ != nullptr; }
+
+private:
+    enum class Op { Copy, Move, Destroy };
+
+    template<typename Fn>
+    static R invokeImpl(void* target, Args&&... args)
+    {
+        return (*static_cast<Fn*>(target))(std::forward<Args>(args)...);
+    }
+
+    template<typename Fn>
+    static void manageImpl(Op op, void* dst, void* src)
+    {
+        switch (op)
+        {
+        case Op::Copy:
+            new (dst) Fn(*static_cast<const Fn*>(src));
+            break;
+        case Op::Move:
+            new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+            break;
+        case Op::Destroy:
+            static_cast<Fn*>(dst)->~Fn();
+            break;
+        }
+    }
+
+    void reset() noexcept
+    {
+        if (manage_) manage_(Op::Destroy, storage_, nullptr);
+        invoke_ = nullptr;
+        manage_ = nullptr;
+    }
+
+    alignas(std::max_align_t) mutable unsigned char storage_[Capacity];
+    R (*invoke_)(void*, Args&&...) = nullptr;
+    void (*manage_)(Op, void*, void*) = nullptr;
+};
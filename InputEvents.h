@@ -15,4 +15,13 @@ struct MouseEvent
     float x, y;
     int button;
     Action action;
-};
\ No newline at end of file
+};
+
+// Consecutive pointer moves queued within one tick collapse into the latest
+// position (see EventChannel::enqueue).
+inline bool coalesceEvent(MouseEvent& last, const MouseEvent& next)
+{
+    if (last.action != MouseEvent::Action::Move || next.action != MouseEvent::Action::Move) return false;
+    last = next;
+    return true;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Binary layout shared by InputRecorder and InputPlayer.
+//
+//   header  : "SWIR" | version u8 | flags u8 | 2 reserved bytes | arena width u32 |
+//             arena height u32 | time step f32
+//   record  : tick delta varint | RecordType u8 | payload
+//   Session : rng seed u32
+//   Key     : key i32 | action u8
+//   Mouse   : x f32 | y f32 | button i8 | action u8
+//
+// Multi-byte fields are little-endian. The tick delta is relative to the
+// previous record, so a burst of input within one tick costs a single zero
+// byte of timing.
+//
+// Every session the recorder sees is appended to the same file: a Session
+// record starts one, its delta is zero and ticks count from zero again after
+// it. The header holds what stays fixed for the whole run, so all of them
+// share the arena, time step and rule flags the recording game ran with.
+//
+// Version 2 seeds the world's std::minstd_rand (Random.h) instead of rand(), so
+// version 1 logs no longer replay and are rejected. Version 3 moves the seed
+// into Session records and stores the arena and time step.
+namespace InputLog
+{
+    constexpr char Magic[4] = { 'S', 'W', 'I', 'R' };
+    constexpr std::uint8_t Version = 3;
+    constexpr std::size_t HeaderSize = 20;
+
+    // Header flags: rules that change how a session plays out.
+    constexpr std::uint8_t AsteroidCollisionsFlag = 1 << 0;
+
+    enum class RecordType : std::uint8_t { Key = 0, Mouse = 1, Session = 2 };
+
+    constexpr std::size_t KeyPayloadSize = 5;
+    constexpr std::size_t MousePayloadSize = 10;
+    constexpr std::size_t SessionPayloadSize = 4;
+
+    inline void putVarint(std::vector<std::uint8_t>& out, std::uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    inline bool getVarint(const std::uint8_t*& p, const std::uint8_t* end, std::uint64_t& value)
+    {
+        value = 0;
+        for (unsigned shift = 0; shift < 64 && p < end; shift += 7)
+        {
+            const std::uint8_t byte = *p++;
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    inline void putU32(std::vector<std::uint8_t>& out, std::uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i) out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+    }
+
+    inline std::uint32_t getU32(const std::uint8_t* p)
+    {
+        return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+            (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+    }
+
+    inline void putF32(std::vector<std::uint8_t>& out, float value)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        putU32(out, bits);
+    }
+
+    inline float getF32(const std::uint8_t* p)
+    {
+        const std::uint32_t bits = getU32(p);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+}
@@ -0,0 +1,96 @@
+#include "InputPlayer.h"
+#include "InputEvents.h"
+#include "InputLog.h"
+#include <cmath>
+#include <cstring>
+
+InputPlayer::InputPlayer(const std::string& path, std::size_t session)
+{
+    if (!file.open(path) || file.size() < InputLog::HeaderSize) return;
+
+    const std::uint8_t* data = file.data();
+    if (std::memcmp(data, InputLog::Magic, sizeof(InputLog::Magic)) != 0 || data[4] != InputLog::Version) return;
+
+    flags = data[5];
+    arenaWidth = InputLog::getU32(data + 8);
+    arenaHeight = InputLog::getU32(data + 12);
+    timeStep = InputLog::getF32(data + 16);
+    // The simulation divides by the arena size and steps by timeStep, so a
+    // corrupt header must not get that far.
+    if (arenaWidth == 0 || arenaHeight == 0 || !std::isfinite(timeStep) || timeStep <= 0.0f) return;
+
+    cursor = data + InputLog::HeaderSize;
+    end = data + file.size();
+
+    // Skip to the requested session's record; playback starts right after it.
+    std::uint64_t delta;
+    std::uint8_t type;
+    const std::uint8_t* payload;
+    std::size_t sessionsSeen = 0;
+    while (decode(delta, type, payload))
+    {
+        if (type != static_cast<std::uint8_t>(InputLog::RecordType::Session)) continue;
+        if (sessionsSeen++ < session) continue;
+
+        seed = InputLog::getU32(payload);
+        valid = true;
+        readNext();
+        return;
+    }
+}
+
+void InputPlayer::enqueueUpTo(std::uint64_t tick, EventBus& bus)
+{
+    while (hasNext && nextTick <= tick)
+    {
+        const std::uint8_t* p = nextPayload;
+        if (nextType == static_cast<std::uint8_t>(InputLog::RecordType::Key))
+        {
+            KeyEvent ev{ static_cast<int>(InputLog::getU32(p)), static_cast<KeyEvent::Action>(p[4]) };
+            bus.enqueue<KeyEvent>(ev);
+        }
+        else
+        {
+            MouseEvent ev{ InputLog::getF32(p), InputLog::getF32(p + 4), static_cast<std::int8_t>(p[8]), static_cast<MouseEvent::Action>(p[9]) };
+            bus.enqueue<MouseEvent>(ev);
+        }
+
+        readNext();
+    }
+}
+
+bool InputPlayer::decode(std::uint64_t& delta, std::uint8_t& type, const std::uint8_t*& payload)
+{
+    if (cursor >= end || !InputLog::getVarint(cursor, end, delta) || cursor >= end) return false;
+
+    type = *cursor++;
+    std::size_t payloadSize;
+    if (type == static_cast<std::uint8_t>(InputLog::RecordType::Key)) payloadSize = InputLog::KeyPayloadSize;
+    else if (type == static_cast<std::uint8_t>(InputLog::RecordType::Mouse)) payloadSize = InputLog::MousePayloadSize;
+    else if (type == static_cast<std::uint8_t>(InputLog::RecordType::Session)) payloadSize = InputLog::SessionPayloadSize;
+    else return false;
+
+    if (static_cast<std::size_t>(end - cursor) < payloadSize) return false;
+
+    payload = cursor;
+    cursor += payloadSize;
+    return true;
+}
+
+// The next session's record ends this one. A truncated or corrupt tail ends
+// the replay instead of failing it: everything decoded up to that point has
+// already been played.
+void InputPlayer::readNext()
+{
+    hasNext = false;
+
+    std::uint64_t delta;
+    std::uint8_t type;
+    const std::uint8_t* payload;
+    if (!decode(delta, type, payload) || type == static_cast<std::uint8_t>(InputLog::RecordType::Session)) return;
+
+    nextTick += delta;
+    nextType = type;
+    nextPayload = payload;
+    hasNext = true;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "EventBus.h"
+#include "InputLog.h"
+#include "MappedFile.h"
+
+// Replays one session of a log written by InputRecorder. The file is
+// memory-mapped and decoded in place, one record ahead of the tick being
+// played.
+class InputPlayer
+{
+public:
+    // session counts from 0, in the order they were recorded.
+    explicit InputPlayer(const std::string& path, std::size_t session = 0);
+
+    InputPlayer(const InputPlayer&) = delete;
+    InputPlayer& operator=(const InputPlayer&) = delete;
+
+    // False if the file is missing, is not an input log or has no such
+    // session.
+    bool isOpen() const noexcept { return valid; }
+    bool finished() const noexcept { return !valid || !hasNext; }
+
+    // The simulation must be built from these, not from the current window.
+    std::uint32_t getSeed() const noexcept { return seed; }
+    std::uint32_t getArenaWidth() const noexcept { return arenaWidth; }
+    std::uint32_t getArenaHeight() const noexcept { return arenaHeight; }
+    float getTimeStep() const noexcept { return timeStep; }
+    bool getAsteroidCollisions() const noexcept { return (flags & InputLog::AsteroidCollisionsFlag) != 0; }
+
+    // Queues on bus every event recorded for ticks up to and including tick,
+    // in recorded order. Call right before the bus is drained for that tick.
+    void enqueueUpTo(std::uint64_t tick, EventBus& bus);
+
+private:
+    // Decodes the record at cursor and moves past it. False at the end of the
+    // file or on a truncated or unknown record.
+    bool decode(std::uint64_t& delta, std::uint8_t& type, const std::uint8_t*& payload);
+    void readNext();
+
+    MappedFile file;
+    const std::uint8_t* cursor{ nullptr };
+    const std::uint8_t* end{ nullptr };
+    std::uint32_t seed{};
+    std::uint32_t arenaWidth{}, arenaHeight{};
+    float timeStep{};
+    std::uint8_t flags{};
+    bool valid{ false };
+
+    bool hasNext{ false };
+    std::uint64_t nextTick{};
+    std::uint8_t nextType{};
+    const std::uint8_t* nextPayload{ nullptr };
+};
@@ -0,0 +1,90 @@
+#include "InputRecorder.h"
+#include "InputLog.h"
+
+namespace
+{
+    constexpr std::size_t FlushThreshold = 64 * 1024;
+}
+
+InputRecorder::InputRecorder(EventBus& bus, const std::string& path, std::uint32_t arenaWidth, std::uint32_t arenaHeight, float timeStep,
+    bool asteroidCollisions)
+    : bus(bus),
+    out(path, std::ios::binary | std::ios::trunc)
+{
+    if (!out.is_open()) return;
+
+    buffer.reserve(FlushThreshold + 64);
+    buffer.insert(buffer.end(), std::begin(InputLog::Magic), std::end(InputLog::Magic));
+    buffer.push_back(InputLog::Version);
+    buffer.push_back(asteroidCollisions ? InputLog::AsteroidCollisionsFlag : 0);
+    buffer.insert(buffer.end(), 2, 0);
+    InputLog::putU32(buffer, arenaWidth);
+    InputLog::putU32(buffer, arenaHeight);
+    InputLog::putF32(buffer, timeStep);
+
+    keySubId = bus.subscribe<KeyEvent>([this](const KeyEvent& ev) { record(ev); });
+    mouseSubId = bus.subscribe<MouseEvent>([this](const MouseEvent& ev) { record(ev); });
+}
+
+InputRecorder::~InputRecorder()
+{
+    if (keySubId) bus.unsubscribe<KeyEvent>(keySubId);
+    if (mouseSubId) bus.unsubscribe<MouseEvent>(mouseSubId);
+    flush();
+}
+
+void InputRecorder::beginSession(std::uint32_t seed)
+{
+    if (!out.is_open()) return;
+
+    tick = 0;
+    lastRecordedTick = 0;
+    inSession = true;
+    beginRecord(static_cast<std::uint8_t>(InputLog::RecordType::Session));
+    InputLog::putU32(buffer, seed);
+}
+
+void InputRecorder::endSession()
+{
+    inSession = false;
+    flush();
+}
+
+void InputRecorder::flush()
+{
+    if (!out.is_open() || buffer.empty()) return;
+    out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    out.flush();
+    buffer.clear();
+}
+
+void InputRecorder::beginRecord(std::uint8_t type)
+{
+    InputLog::putVarint(buffer, tick - lastRecordedTick);
+    lastRecordedTick = tick;
+    buffer.push_back(type);
+}
+
+void InputRecorder::record(const KeyEvent& ev)
+{
+    if (!inSession) return;
+
+    beginRecord(static_cast<std::uint8_t>(InputLog::RecordType::Key));
+    InputLog::putU32(buffer, static_cast<std::uint32_t>(ev.key));
+    buffer.push_back(static_cast<std::uint8_t>(ev.action));
+
+    if (buffer.size() >= FlushThreshold) flush();
+}
+
+void InputRecorder::record(const MouseEvent& ev)
+{
+    if (!inSession) return;
+
+    beginRecord(static_cast<std::uint8_t>(InputLog::RecordType::Mouse));
+    InputLog::putF32(buffer, ev.x);
+    InputLog::putF32(buffer, ev.y);
+    buffer.push_back(static_cast<std::uint8_t>(static_cast<std::int8_t>(ev.button)));
+    buffer.push_back(static_cast<std::uint8_t>(ev.action));
+
+    if (buffer.size() >= FlushThreshold) flush();
+}
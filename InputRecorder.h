@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "EventBus.h"
+#include "InputEvents.h"
+
+// Writes every KeyEvent / MouseEvent delivered on a bus during a session to a
+// compact binary log (see InputLog.h), stamped with the simulation tick it was
+// delivered on. One recorder lives for the whole run and appends each session
+// to the same file; events outside a session are not written.
+class InputRecorder
+{
+public:
+    InputRecorder(EventBus& bus, const std::string& path, std::uint32_t arenaWidth, std::uint32_t arenaHeight, float timeStep,
+        bool asteroidCollisions);
+    ~InputRecorder();
+
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    bool isOpen() const { return out.is_open(); }
+
+    // Starts recording a session at tick 0; ends the current one, if any.
+    void beginSession(std::uint32_t seed);
+    void endSession();
+
+    // Tick that events delivered from now on belong to.
+    void setTick(std::uint64_t newTick) noexcept { tick = newTick; }
+
+    void flush();
+
+private:
+    void beginRecord(std::uint8_t type);
+    void record(const KeyEvent& ev);
+    void record(const MouseEvent& ev);
+
+    EventBus& bus;
+    std::ofstream out;
+    std::vector<std::uint8_t> buffer;
+    std::uint64_t tick{};
+    std::uint64_t lastRecordedTick{};
+    bool inSession{ false };
+
+    EventBus::HandlerId keySubId{0};
+    EventBus::HandlerId mouseSubId{0};
+};
@@ -0,0 +1,189 @@
+#include "Kinematics.h"
+#include <atomic>
+#include "SimdDispatch.h"
+
+namespace
+{
+    using IntegrateFn = void (*)(float*, float*, const float*, const float*, const float*, std::size_t, float);
+
+    // Shared by the scalar path and the SIMD tails: (dir * speed) * dt, then add.
+    inline void integrateRange(float* posX, float* posY, const float* dirX, const float* dirY, const float* speed,
+        std::size_t begin, std::size_t end, float deltaTime)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const float stepX = dirX[i] * speed[i] * deltaTime;
+            const float stepY = dirY[i] * speed[i] * deltaTime;
+            posX[i] += stepX;
+            posY[i] += stepY;
+        }
+    }
+
+#ifdef SIMD_X86
+    bool cpuHasAvx2()
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+
+        // AVX state must also be enabled by the OS (OSXSAVE, then XCR0 bits 1-2).
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+    bool cpuHasSse2()
+    {
+#if defined(_M_X64) || defined(__x86_64__)
+        return true;
+#elif defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 1);
+        return (info[3] & (1 << 26)) != 0;
+#else
+        return __builtin_cpu_supports("sse2");
+#endif
+    }
+#endif
+
+    IntegrateFn functionFor(Kinematics::Path path)
+    {
+        switch (path)
+        {
+        case Kinematics::Path::AVX2: return &Kinematics::integrateAVX2;
+        case Kinematics::Path::SSE2: return &Kinematics::integrateSSE2;
+        default: return &Kinematics::integrateScalar;
+        }
+    }
+
+    Kinematics::Path detectPath()
+    {
+        if (Kinematics::isSupported(Kinematics::Path::AVX2)) return Kinematics::Path::AVX2;
+        if (Kinematics::isSupported(Kinematics::Path::SSE2)) return Kinematics::Path::SSE2;
+        return Kinematics::Path::Scalar;
+    }
+
+    std::atomic<Kinematics::Path>& activePathRef()
+    {
+        static std::atomic<Kinematics::Path> path{ detectPath() };
+        return path;
+    }
+
+    std::atomic<IntegrateFn>& activeFunctionRef()
+    {
+        static std::atomic<IntegrateFn> fn{ functionFor(activePathRef().load()) };
+        return fn;
+    }
+}
+
+namespace Kinematics
+{
+    void integrate(float* posX, float* posY, const float* dirX, const float* dirY, const float* speed,
+        std::size_t count, float deltaTime)
+    {
+        activeFunctionRef().load(std::memory_order_relaxed)(posX, posY, dirX, dirY, speed, count, deltaTime);
+    }
+
+    void integrateScalar(float* posX, float* posY, const float* dirX, const float* dirY, const float* speed,
+        std::size_t count, float deltaTime)
+    {
+        integrateRange(posX, posY, dirX, dirY, speed, 0, count, deltaTime);
+    }
+
+#ifdef SIMD_X86
+    SIMD_TARGET_SSE2
+    void integrateSSE2(float* posX, float* posY, const float* dirX, const float* dirY, const float* speed,
+        std::size_t count, float deltaTime)
+    {
+        const __m128 dt = _mm_set1_ps(deltaTime);
+        const std::size_t vectorEnd = count & ~static_cast<std::size_t>(3);
+
+        for (std::size_t i = 0; i < vectorEnd; i += 4)
+        {
+            const __m128 s = _mm_loadu_ps(speed + i);
+            const __m128 stepX = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(dirX + i), s), dt);
+            const __m128 stepY = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(dirY + i), s), dt);
+            _mm_storeu_ps(posX + i, _mm_add_ps(_mm_loadu_ps(posX + i), stepX));
+            _mm_storeu_ps(posY + i, _mm_add_ps(_mm_loadu_ps(posY + i), stepY));
+        }
+
+        integrateRange(posX, posY, dirX, dirY, speed, vectorEnd, count, deltaTime);
+    }
+
+    SIMD_TARGET_AVX2
+    void integrateAVX2(float* posX, float* posY, const float* dirX, const float* dirY, const float* speed,
+        std::size_t count, float deltaTime)
+    {
+        const __m256 dt = _mm256_set1_ps(deltaTime);
+        const std::size_t vectorEnd = count & ~static_cast<std::size_t>(7);
+
+        for (std::size_t i = 0; i < vectorEnd; i += 8)
+        {
+            const __m256 s = _mm256_loadu_ps(speed + i);
+            const __m256 stepX = _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(dirX + i), s), dt);
+            const __m256 stepY = _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(dirY + i), s), dt);
+            _mm256_storeu_ps(posX + i, _mm256_add_ps(_mm256_loadu_ps(posX + i), stepX));
+            _mm256_storeu_ps(posY + i, _mm256_add_ps(_mm256_loadu_ps(posY + i), stepY));
+        }
+
+        integrateRange(posX, posY, dirX, dirY, speed, vectorEnd, count, deltaTime);
+    }
+#else
+    void integrateSSE2(float* posX, float* posY, const float* dirX, const float* dirY, const float* speed,
+        std::size_t count, float deltaTime)
+    {
+        integrateScalar(posX, posY, dirX, dirY, speed, count, deltaTime);
+    }
+
+    void integrateAVX2(float* posX, float* posY, const float* dirX, const float* dirY, const float* speed,
+        std::size_t count, float deltaTime)
+    {
+        integrateScalar(posX, posY, dirX, dirY, speed, count, deltaTime);
+    }
+#endif
+
+    bool isSupported(Path path) noexcept
+    {
+        switch (path)
+        {
+#ifdef SIMD_X86
+        case Path::AVX2: return cpuHasAvx2();
+        case Path::SSE2: return cpuHasSse2();
+#endif
+        case Path::Scalar: return true;
+        default: return false;
+        }
+    }
+
+    Path activePath() noexcept
+    {
+        return activePathRef().load();
+    }
+
+    bool setActivePath(Path path) noexcept
+    {
+        if (!isSupported(path)) return false;
+
+        activePathRef().store(path);
+        activeFunctionRef().store(functionFor(path));
+        return true;
+    }
+
+    const char* pathName(Path path) noexcept
+    {
+        switch (path)
+        {
+        case Path::AVX2: return "AVX2";
+        case Path::SSE2: return "SSE2";
+        default: return "scalar";
+        }
+    }
+}
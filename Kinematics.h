@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "AlignedAllocator.h"
+
+// Position integration over Structure-of-Arrays data,
+//
+//     pos += dir * speed * dt    (for x and y)
+//
+// with SSE2 and AVX2 paths picked at runtime from the CPU's features. Every
+// path performs the same IEEE single-precision operations in the same order
+// (two multiplies, then the add, never fused), so the results are
+// bit-identical whichever path runs and replays stay deterministic across
+// machines. FMA contraction is kept off for Kinematics.cpp (/fp:contract- in
+// Spacewar.vcxproj, -ffp-contract=off in the benchmark build lines).
+namespace Kinematics
+{
+    enum class Path { Scalar, SSE2, AVX2 };
+
+    void integrate(float* posX, float* posY, const float* dirX, const float* dirY, const float* speed,
+        std::size_t count, float deltaTime);
+
+    // Individual paths, for benchmarks and comparisons. Calling a path the CPU
+    // does not support is undefined; check isSupported() first.
+    void integrateScalar(float* posX, float* posY, const float* dirX, const float* dirY, const float* speed,
+        std::size_t count, float deltaTime);
+    void integrateSSE2(float* posX, float* posY, const float* dirX, const float* dirY, const float* speed,
+        std::size_t count, float deltaTime);
+    void integrateAVX2(float* posX, float* posY, const float* dirX, const float* dirY, const float* speed,
+        std::size_t count, float deltaTime);
+
+    bool isSupported(Path path) noexcept;
+
+    // Path used by integrate(): the widest supported one unless overridden.
+    Path activePath() noexcept;
+    // Returns false, leaving the active path alone, if path is not supported.
+    bool setActivePath(Path path) noexcept;
+
+    const char* pathName(Path path) noexcept;
+
+    // Scratch columns for entities whose state is not stored as columns yet:
+    // gather into the batch, integrate, scatter back. Capacity is kept
+    // between ticks, so a steady population does not allocate.
+    struct Batch
+    {
+        template <typename T>
+        using Column = std::vector<T, AlignedAllocator<T, 64>>;
+
+        Column<float> posX, posY;
+        Column<float> dirX, dirY, speed;
+
+        void resize(std::size_t count)
+        {
+            posX.resize(count);
+            posY.resize(count);
+            dirX.resize(count);
+            dirY.resize(count);
+            speed.resize(count);
+        }
+
+        std::size_t size() const noexcept { return posX.size(); }
+
+        void integrate(float deltaTime)
+        {
+            Kinematics::integrate(posX.data(), posY.data(), dirX.data(), dirY.data(), speed.data(), size(), deltaTime);
+        }
+    };
+}
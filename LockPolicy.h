@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <shared_mutex>
+#include <thread>
+
+// Locking policies for containers that are only sometimes shared between
+// threads. Each one is SharedLockable (lock/unlock, lock_shared/unlock_shared),
+// so std::unique_lock and std::shared_lock work with all of them.
+//
+// IsConcurrent tells the container whether it needs more than the lock, such
+// as the sequence counters that let its getters run without one.
+
+// Single-threaded use. Every call is empty and inlines away.
+struct NullLock
+{
+    static constexpr bool IsConcurrent = false;
+
+    void lock() noexcept {}
+    void unlock() noexcept {}
+    void lock_shared() noexcept {}
+    void unlock_shared() noexcept {}
+};
+
+class SharedMutexLock
+{
+public:
+    static constexpr bool IsConcurrent = true;
+
+    void lock() { mutex_.lock(); }
+    void unlock() { mutex_.unlock(); }
+    void lock_shared() { mutex_.lock_shared(); }
+    void unlock_shared() { mutex_.unlock_shared(); }
+
+private:
+    std::shared_mutex mutex_;
+};
+
+// Reader-writer spinlock in one word: the top bit is the writer, the rest
+// count readers. A writer claims the bit first, which stops new readers, and
+// then waits for the current ones to leave. Only worth it for critical
+// sections much shorter than a context switch.
+class SpinRWLock
+{
+public:
+    static constexpr bool IsConcurrent = true;
+
+    void lock() noexcept
+    {
+        std::uint32_t state = state_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            if (!(state & Writer) &&
+                state_.compare_exchange_weak(state, state | Writer, std::memory_order_acquire, std::memory_order_relaxed))
+                break;
+            backOff();
+            state = state_.load(std::memory_order_relaxed);
+        }
+
+        while (state_.load(std::memory_order_acquire) != Writer) backOff();
+    }
+
+    void unlock() noexcept { state_.store(0, std::memory_order_release); }
+
+    void lock_shared() noexcept
+    {
+        std::uint32_t state = state_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            if (!(state & Writer) &&
+                state_.compare_exchange_weak(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                return;
+            backOff();
+            state = state_.load(std::memory_order_relaxed);
+        }
+    }
+
+    void unlock_shared() noexcept { state_.fetch_sub(1, std::memory_order_release); }
+
+private:
+    static constexpr std::uint32_t Writer = 1u << 31;
+
+    // Yield rather than pause: the holder may be waiting for this very core.
+    static void backOff() noexcept { std::this_thread::yield(); }
+
+    std::atomic<std::uint32_t> state_{ 0 };
+};
+
+// The game steps its simulation on one thread; define
+// SPACEWAR_CONCURRENT_COMPONENTS to share component stores across threads.
+#ifdef SPACEWAR_CONCURRENT_COMPONENTS
+using ComponentLockPolicy = SharedMutexLock;
+#else
+using ComponentLockPolicy = NullLock;
+#endif
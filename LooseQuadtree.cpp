@@ -0,0 +1,184 @@
+#include "LooseQuadtree.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+
+void LooseQuadtree::build(const ColliderBatch& newColliders)
+{
+    colliders = &newColliders;
+    const std::size_t count = newColliders.size();
+
+    nodes.clear();
+    items.resize(count);
+    itemNode.resize(count);
+    if (count == 0) return;
+
+    float minX = newColliders.posX[0], maxX = minX;
+    float minY = newColliders.posY[0], maxY = minY;
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        minX = std::min(minX, newColliders.posX[i]);
+        maxX = std::max(maxX, newColliders.posX[i]);
+        minY = std::min(minY, newColliders.posY[i]);
+        maxY = std::max(maxY, newColliders.posY[i]);
+    }
+
+    // A little slack so centres on the far edge still fall inside.
+    const float rootHalfSize = std::max(maxX - minX, maxY - minY) * 0.5f + 1.0f;
+    addNode((minX + maxX) * 0.5f, (minY + maxY) * 0.5f, rootHalfSize);
+
+    // 4^depth nodes at the deepest level share the circles.
+    int depthLimit = 0;
+    while (depthLimit < MaxDepth && (std::size_t{ 1 } << (2 * (depthLimit + 1))) * LeafCapacity <= count) ++depthLimit;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const float x = newColliders.posX[i];
+        const float y = newColliders.posY[i];
+        const float radius = newColliders.radius[i];
+
+        std::int32_t node = 0;
+        for (int depth = 0; depth < depthLimit; ++depth)
+        {
+            const float childHalfSize = nodes[node].halfSize * 0.5f;
+            if (radius > childHalfSize) break;
+
+            const int quadrant = (x >= nodes[node].centerX ? 1 : 0) + (y >= nodes[node].centerY ? 2 : 0);
+            std::int32_t child = nodes[node].children[quadrant];
+            if (child == NoNode)
+            {
+                const float childX = nodes[node].centerX + (quadrant & 1 ? childHalfSize : -childHalfSize);
+                const float childY = nodes[node].centerY + (quadrant & 2 ? childHalfSize : -childHalfSize);
+                child = addNode(childX, childY, childHalfSize);
+                nodes[node].children[quadrant] = child;
+            }
+            node = child;
+        }
+
+        itemNode[i] = node;
+        ++nodes[node].itemCount;
+    }
+
+    std::uint32_t first = 0;
+    for (Node& node : nodes)
+    {
+        node.firstItem = first;
+        first += node.itemCount;
+        node.itemCount = 0;
+    }
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Node& node = nodes[itemNode[i]];
+        items[node.firstItem + node.itemCount++] = static_cast<std::uint32_t>(i);
+    }
+}
+
+std::int32_t LooseQuadtree::addNode(float centerX, float centerY, float halfSize)
+{
+    nodes.push_back(Node{ centerX, centerY, halfSize, { NoNode, NoNode, NoNode, NoNode }, 0, 0 });
+    return static_cast<std::int32_t>(nodes.size() - 1);
+}
+
+template <typename Fn>
+void LooseQuadtree::forEachCandidate(float x, float y, float radius, Fn&& fn) const
+{
+    if (nodes.empty()) return;
+
+    // Depth-first; each level leaves at most three siblings waiting.
+    std::array<std::int32_t, 3 * MaxDepth + 4> stack;
+    std::size_t top = 0;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        const Node& node = nodes[stack[--top]];
+
+        // The root keeps circles of any size, so its bounds are unlimited.
+        const float looseHalfSize = &node == &nodes[0] ? std::numeric_limits<float>::infinity() : 2.0f * node.halfSize;
+        if (std::abs(x - node.centerX) > looseHalfSize + radius || std::abs(y - node.centerY) > looseHalfSize + radius) continue;
+
+        // A node holds circles anywhere in its loose bounds: weed out those
+        // whose own bounding box misses the query's.
+        for (std::uint32_t i = node.firstItem; i < node.firstItem + node.itemCount; ++i)
+        {
+            const std::uint32_t index = items[i];
+            const float reach = radius + colliders->radius[index];
+            if (std::abs(x - colliders->posX[index]) <= reach && std::abs(y - colliders->posY[index]) <= reach) fn(index);
+        }
+
+        for (std::int32_t child : node.children)
+        {
+            if (child != NoNode) stack[top++] = child;
+        }
+    }
+}
+
+void LooseQuadtree::queryCircle(float x, float y, float radius, std::vector<std::uint32_t>& out) const
+{
+    forEachCandidate(x, y, radius, [&](std::uint32_t index) { out.push_back(index); });
+}
+
+// Best-first over nodes, ordered by a lower bound on the distance to any
+// circle below them: the distance to the node's cell, which holds every
+// centre, less its half size, which bounds every radius.
+std::uint32_t LooseQuadtree::nearest(float x, float y) const
+{
+    if (nodes.empty()) return NoCollider;
+
+    struct Pending
+    {
+        float bound;
+        std::int32_t node;
+        bool operator>(const Pending& other) const noexcept { return bound > other.bound; }
+    };
+    std::priority_queue<Pending, std::vector<Pending>, std::greater<Pending>> queue;
+    queue.push({ -std::numeric_limits<float>::infinity(), 0 });
+
+    std::uint32_t best = NoCollider;
+    float bestDistance = std::numeric_limits<float>::infinity();
+
+    while (!queue.empty() && queue.top().bound <= bestDistance)
+    {
+        const Node& node = nodes[queue.top().node];
+        queue.pop();
+
+        for (std::uint32_t i = node.firstItem; i < node.firstItem + node.itemCount; ++i)
+        {
+            const std::uint32_t index = items[i];
+            const float dx = x - colliders->posX[index];
+            const float dy = y - colliders->posY[index];
+            const float distance = std::sqrt(dx * dx + dy * dy) - colliders->radius[index];
+            if (distance < bestDistance || (distance == bestDistance && index < best))
+            {
+                best = index;
+                bestDistance = distance;
+            }
+        }
+
+        for (std::int32_t child : node.children)
+        {
+            if (child == NoNode) continue;
+
+            const Node& c = nodes[child];
+            const float outsideX = std::max(std::abs(x - c.centerX) - c.halfSize, 0.0f);
+            const float outsideY = std::max(std::abs(y - c.centerY) - c.halfSize, 0.0f);
+            queue.push({ std::sqrt(outsideX * outsideX + outsideY * outsideY) - c.halfSize, child });
+        }
+    }
+
+    return best;
+}
+
+void LooseQuadtree::findPairs(std::vector<ColliderPair>& out) const
+{
+    for (std::uint32_t i = 0; i < items.size(); ++i)
+    {
+        forEachCandidate(colliders->posX[i], colliders->posY[i], colliders->radius[i], [&](std::uint32_t other)
+        {
+            if (other > i) out.push_back(ColliderPair{ i, other });
+        });
+    }
+}
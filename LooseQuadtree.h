@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ColliderBatch.h"
+
+// Loose quadtree broadphase over circles: each node's bounds are twice its
+// cell, so a circle lives in the deepest node whose cell holds its centre and
+// whose size is at least its diameter, and never straddles siblings. Small
+// asteroids sink to small nodes while a zone-sized circle stays near the
+// root, so mixed radii cost no more than uniform ones, unlike SpatialHash
+// where the largest circle sets every cell's size.
+//
+// Small circles stop sinking once nodes would hold about LeafCapacity
+// circles on average, so the tree stays shallow.
+//
+// Rebuilt every tick: one descent per circle, then a counting sort of the
+// circles by node. Storage is kept between ticks. Implements the broadphase
+// interface described in Broadphase.h.
+class LooseQuadtree
+{
+public:
+    static constexpr int MaxDepth = 12;
+    // Circles per deepest node, on average, that the depth limit aims for.
+    static constexpr std::size_t LeafCapacity = 8;
+
+    void build(const ColliderBatch& colliders);
+
+    void queryCircle(float x, float y, float radius, std::vector<std::uint32_t>& out) const;
+    std::uint32_t nearest(float x, float y) const;
+    void findPairs(std::vector<ColliderPair>& out) const;
+
+    std::size_t size() const noexcept { return items.size(); }
+
+private:
+    static constexpr std::int32_t NoNode = -1;
+
+    struct Node
+    {
+        float centerX, centerY;
+        // Half the cell's side. Circles filed here have radius <= halfSize
+        // (except at the root) and their centre inside the cell, so they lie
+        // within twice the cell.
+        float halfSize;
+        std::int32_t children[4];
+        std::uint32_t firstItem, itemCount;
+    };
+
+    std::int32_t addNode(float centerX, float centerY, float halfSize);
+
+    // fn(index) for every circle whose bounding box overlaps the query
+    // circle's, visiting only nodes whose loose bounds do.
+    template <typename Fn>
+    void forEachCandidate(float x, float y, float radius, Fn&& fn) const;
+
+    const ColliderBatch* colliders{ nullptr };
+
+    std::vector<Node> nodes;
+    // Circle indices grouped by node; node n holds items[firstItem, firstItem + itemCount).
+    std::vector<std::uint32_t> items;
+    // Node of each circle, in input order, before the sort.
+    std::vector<std::int32_t> itemNode;
+};
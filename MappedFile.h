@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only memory mapping of a whole file.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close() noexcept;
+
+    const std::uint8_t* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    bool isOpen() const noexcept { return data_ != nullptr || opened_; }
+
+private:
+    const std::uint8_t* data_{ nullptr };
+    std::size_t size_{ 0 };
+    bool opened_{ false };
+
+#ifdef _WIN32
+    void* file_{ nullptr };
+    void* mapping_{ nullptr };
+#endif
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+struct QueueStats
+{
+    std::uint64_t pushed{};
+    std::uint64_t dropped{};
+    std::size_t highWater{};
+    std::size_t capacity{};
+};
+
+// Bounded lock-free queue for many producer threads and one consumer thread.
+//
+// Every cell carries a sequence number telling producers whether it is free
+// for their ticket and the consumer whether it has been filled, so producers
+// only contend on the enqueue counter and never wait for each other. A full
+// queue rejects the push instead of blocking; the rejection is counted.
+template<typename T>
+class BoundedMpscQueue
+{
+public:
+    using Stats = QueueStats;
+
+    // capacity is rounded up to a power of two.
+    explicit BoundedMpscQueue(std::size_t capacity)
+    {
+        if (capacity < 2) capacity = 2;
+        std::size_t rounded = 1;
+        while (rounded < capacity)
+        {
+            if (rounded > (static_cast<std::size_t>(-1) >> 2)) throw std::length_error("BoundedMpscQueue: capacity too large");
+            rounded <<= 1;
+        }
+
+        mask_ = rounded - 1;
+        cells_ = std::make_unique<Cell[]>(rounded);
+        for (std::size_t i = 0; i < rounded; ++i) cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    BoundedMpscQueue(const BoundedMpscQueue&) = delete;
+    BoundedMpscQueue& operator=(const BoundedMpscQueue&) = delete;
+
+    // Any thread.
+    bool tryPush(const T& value)
+    {
+        std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;)
+        {
+            cell = &cells_[pos & mask_];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if (diff < 0)
+            {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else
+            {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+
+        const std::size_t consumed = dequeuePos_.load(std::memory_order_relaxed);
+        if (consumed <= pos) noteOccupancy(pos + 1 - consumed);
+        return true;
+    }
+
+    // Consumer thread only.
+    bool tryPop(T& out)
+    {
+        const std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        Cell& cell = cells_[pos & mask_];
+        const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1) < 0) return false;
+
+        out = cell.value;
+        cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+        dequeuePos_.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Approximate while producers are active.
+    Stats stats() const noexcept
+    {
+        Stats s;
+        s.pushed = enqueuePos_.load(std::memory_order_relaxed);
+        s.dropped = dropped_.load(std::memory_order_relaxed);
+        s.highWater = highWater_.load(std::memory_order_relaxed);
+        s.capacity = mask_ + 1;
+        return s;
+    }
+
+    std::size_t capacity() const noexcept { return mask_ + 1; }
+
+private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence{0};
+        T value{};
+    };
+
+    void noteOccupancy(std::size_t occupancy) noexcept
+    {
+        std::size_t seen = highWater_.load(std::memory_order_relaxed);
+        while (occupancy > seen && !highWater_.compare_exchange_weak(seen, occupancy, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    std::unique_ptr<Cell[]> cells_;
+    std::size_t mask_{};
+
+    alignas(64) std::atomic<std::size_t> enqueuePos_{0};
+    alignas(64) std::atomic<std::size_t> dequeuePos_{0};
+    alignas(64) std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::size_t> highWater_{0};
+};
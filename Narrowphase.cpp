@@ -0,0 +1,258 @@
+#include "Narrowphase.h"
+#include <atomic>
+#include <cmath>
+#include "SimdDispatch.h"
+
+namespace
+{
+    // The one test every path performs, in this order: two differences, two
+    // squares, their sum; the radius sum and its square; then compare.
+    inline bool overlaps(float x, float y, float radius, float otherX, float otherY, float otherRadius)
+    {
+        const float dx = x - otherX;
+        const float dy = y - otherY;
+        const float distanceSquared = dx * dx + dy * dy;
+        const float reach = radius + otherRadius;
+        return distanceSquared <= reach * reach;
+    }
+
+    std::size_t overlapCircleScalar(float x, float y, float radius, const float* posX, const float* posY, const float* radii,
+        std::size_t begin, std::size_t count, std::uint32_t* hits)
+    {
+        std::size_t hitCount = 0;
+        for (std::size_t i = begin; i < count; ++i)
+        {
+            if (overlaps(x, y, radius, posX[i], posY[i], radii[i])) hits[hitCount++] = static_cast<std::uint32_t>(i);
+        }
+        return hitCount;
+    }
+
+    std::size_t overlapCandidatesScalar(float x, float y, float radius, const float* posX, const float* posY, const float* radii,
+        const std::uint32_t* candidates, std::size_t begin, std::size_t count, std::uint32_t* hits)
+    {
+        std::size_t hitCount = 0;
+        for (std::size_t i = begin; i < count; ++i)
+        {
+            const std::uint32_t c = candidates[i];
+            if (overlaps(x, y, radius, posX[c], posY[c], radii[c])) hits[hitCount++] = c;
+        }
+        return hitCount;
+    }
+
+    std::size_t overlapPairsScalar(const float* posX, const float* posY, const float* radii,
+        const ColliderPair* pairs, std::size_t begin, std::size_t count, ColliderPair* hits)
+    {
+        std::size_t hitCount = 0;
+        for (std::size_t i = begin; i < count; ++i)
+        {
+            const std::uint32_t a = pairs[i].first, b = pairs[i].second;
+            if (overlaps(posX[a], posY[a], radii[a], posX[b], posY[b], radii[b])) hits[hitCount++] = pairs[i];
+        }
+        return hitCount;
+    }
+
+#ifdef SIMD_X86
+    inline unsigned lowestBit(unsigned mask)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+    }
+
+    // emit(lane) for every set lane of mask, lowest lane first.
+    template <typename Emit>
+    inline void emitLanes(unsigned mask, Emit&& emit)
+    {
+        while (mask)
+        {
+            emit(lowestBit(mask));
+            mask &= mask - 1;
+        }
+    }
+
+    SIMD_TARGET_SSE2
+    inline unsigned overlapMaskSSE2(__m128 x, __m128 y, __m128 radius, __m128 otherX, __m128 otherY, __m128 otherRadius)
+    {
+        const __m128 dx = _mm_sub_ps(x, otherX);
+        const __m128 dy = _mm_sub_ps(y, otherY);
+        const __m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        const __m128 reach = _mm_add_ps(radius, otherRadius);
+        return static_cast<unsigned>(_mm_movemask_ps(_mm_cmple_ps(distanceSquared, _mm_mul_ps(reach, reach))));
+    }
+
+    SIMD_TARGET_AVX2
+    inline unsigned overlapMaskAVX2(__m256 x, __m256 y, __m256 radius, __m256 otherX, __m256 otherY, __m256 otherRadius)
+    {
+        const __m256 dx = _mm256_sub_ps(x, otherX);
+        const __m256 dy = _mm256_sub_ps(y, otherY);
+        const __m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        const __m256 reach = _mm256_add_ps(radius, otherRadius);
+        return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(distanceSquared, _mm256_mul_ps(reach, reach), _CMP_LE_OQ)));
+    }
+
+    SIMD_TARGET_SSE2
+    std::size_t overlapCircleSSE2(float x, float y, float radius, const float* posX, const float* posY, const float* radii,
+        std::size_t count, std::uint32_t* hits)
+    {
+        const __m128 qx = _mm_set1_ps(x), qy = _mm_set1_ps(y), qr = _mm_set1_ps(radius);
+        const std::size_t vectorEnd = count & ~static_cast<std::size_t>(3);
+
+        std::size_t hitCount = 0;
+        for (std::size_t i = 0; i < vectorEnd; i += 4)
+        {
+            const unsigned mask = overlapMaskSSE2(qx, qy, qr, _mm_loadu_ps(posX + i), _mm_loadu_ps(posY + i), _mm_loadu_ps(radii + i));
+            emitLanes(mask, [&](unsigned lane) { hits[hitCount++] = static_cast<std::uint32_t>(i + lane); });
+        }
+
+        return hitCount + overlapCircleScalar(x, y, radius, posX, posY, radii, vectorEnd, count, hits + hitCount);
+    }
+
+    SIMD_TARGET_AVX2
+    std::size_t overlapCircleAVX2(float x, float y, float radius, const float* posX, const float* posY, const float* radii,
+        std::size_t count, std::uint32_t* hits)
+    {
+        const __m256 qx = _mm256_set1_ps(x), qy = _mm256_set1_ps(y), qr = _mm256_set1_ps(radius);
+        const std::size_t vectorEnd = count & ~static_cast<std::size_t>(7);
+
+        std::size_t hitCount = 0;
+        for (std::size_t i = 0; i < vectorEnd; i += 8)
+        {
+            const unsigned mask = overlapMaskAVX2(qx, qy, qr, _mm256_loadu_ps(posX + i), _mm256_loadu_ps(posY + i), _mm256_loadu_ps(radii + i));
+            emitLanes(mask, [&](unsigned lane) { hits[hitCount++] = static_cast<std::uint32_t>(i + lane); });
+        }
+
+        return hitCount + overlapCircleScalar(x, y, radius, posX, posY, radii, vectorEnd, count, hits + hitCount);
+    }
+
+    // SSE2 has no gather: candidates are loaded lane by lane.
+    SIMD_TARGET_SSE2
+    std::size_t overlapCandidatesSSE2(float x, float y, float radius, const float* posX, const float* posY, const float* radii,
+        const std::uint32_t* candidates, std::size_t count, std::uint32_t* hits)
+    {
+        const __m128 qx = _mm_set1_ps(x), qy = _mm_set1_ps(y), qr = _mm_set1_ps(radius);
+        const std::size_t vectorEnd = count & ~static_cast<std::size_t>(3);
+
+        std::size_t hitCount = 0;
+        for (std::size_t i = 0; i < vectorEnd; i += 4)
+        {
+            const std::uint32_t* c = candidates + i;
+            const unsigned mask = overlapMaskSSE2(qx, qy, qr,
+                _mm_setr_ps(posX[c[0]], posX[c[1]], posX[c[2]], posX[c[3]]),
+                _mm_setr_ps(posY[c[0]], posY[c[1]], posY[c[2]], posY[c[3]]),
+                _mm_setr_ps(radii[c[0]], radii[c[1]], radii[c[2]], radii[c[3]]));
+            emitLanes(mask, [&](unsigned lane) { hits[hitCount++] = c[lane]; });
+        }
+
+        return hitCount + overlapCandidatesScalar(x, y, radius, posX, posY, radii, candidates, vectorEnd, count, hits + hitCount);
+    }
+
+    SIMD_TARGET_AVX2
+    inline __m256 loadLanes(const float* values, const std::uint32_t* c)
+    {
+        return _mm256_setr_ps(values[c[0]], values[c[1]], values[c[2]], values[c[3]], values[c[4]], values[c[5]], values[c[6]], values[c[7]]);
+    }
+
+    // Lane-by-lane loads rather than vgatherdps, which is no faster than
+    // scalar loads on most cores and slower on some.
+    SIMD_TARGET_AVX2
+    std::size_t overlapCandidatesAVX2(float x, float y, float radius, const float* posX, const float* posY, const float* radii,
+        const std::uint32_t* candidates, std::size_t count, std::uint32_t* hits)
+    {
+        const __m256 qx = _mm256_set1_ps(x), qy = _mm256_set1_ps(y), qr = _mm256_set1_ps(radius);
+        const std::size_t vectorEnd = count & ~static_cast<std::size_t>(7);
+
+        std::size_t hitCount = 0;
+        for (std::size_t i = 0; i < vectorEnd; i += 8)
+        {
+            const std::uint32_t* c = candidates + i;
+            const unsigned mask = overlapMaskAVX2(qx, qy, qr, loadLanes(posX, c), loadLanes(posY, c), loadLanes(radii, c));
+            emitLanes(mask, [&](unsigned lane) { hits[hitCount++] = c[lane]; });
+        }
+
+        return hitCount + overlapCandidatesScalar(x, y, radius, posX, posY, radii, candidates, vectorEnd, count, hits + hitCount);
+    }
+#endif
+
+    std::atomic<Narrowphase::Path>& activePathRef()
+    {
+        static std::atomic<Narrowphase::Path> path{ Kinematics::activePath() };
+        return path;
+    }
+}
+
+namespace Narrowphase
+{
+    std::size_t overlapCircle(float x, float y, float radius, const float* posX, const float* posY, const float* radii,
+        std::size_t count, std::uint32_t* hits)
+    {
+        switch (activePathRef().load(std::memory_order_relaxed))
+        {
+#ifdef SIMD_X86
+        case Path::AVX2: return overlapCircleAVX2(x, y, radius, posX, posY, radii, count, hits);
+        case Path::SSE2: return overlapCircleSSE2(x, y, radius, posX, posY, radii, count, hits);
+#endif
+        default: return overlapCircleScalar(x, y, radius, posX, posY, radii, 0, count, hits);
+        }
+    }
+
+    std::size_t overlapCandidates(float x, float y, float radius, const float* posX, const float* posY, const float* radii,
+        const std::uint32_t* candidates, std::size_t count, std::uint32_t* hits)
+    {
+        switch (activePathRef().load(std::memory_order_relaxed))
+        {
+#ifdef SIMD_X86
+        case Path::AVX2: return overlapCandidatesAVX2(x, y, radius, posX, posY, radii, candidates, count, hits);
+        case Path::SSE2: return overlapCandidatesSSE2(x, y, radius, posX, posY, radii, candidates, count, hits);
+#endif
+        default: return overlapCandidatesScalar(x, y, radius, posX, posY, radii, candidates, 0, count, hits);
+        }
+    }
+
+    std::size_t overlapPairs(const float* posX, const float* posY, const float* radii,
+        const ColliderPair* pairs, std::size_t count, ColliderPair* hits)
+    {
+        return overlapPairsScalar(posX, posY, radii, pairs, 0, count, hits);
+    }
+
+    // In the frame of the other circle the first moves by v from d0, and
+    // |d0 + t v|^2 = reach^2 is a quadratic in t; the smaller root is the
+    // first touch.
+    float sweptContact(float x0, float y0, float x1, float y1,
+        float otherX0, float otherY0, float otherX1, float otherY1, float reach)
+    {
+        const float dx = x0 - otherX0;
+        const float dy = y0 - otherY0;
+        const float c = dx * dx + dy * dy - reach * reach;
+        if (c <= 0.0f) return 0.0f;
+
+        const float vx = (x1 - x0) - (otherX1 - otherX0);
+        const float vy = (y1 - y0) - (otherY1 - otherY0);
+        const float a = vx * vx + vy * vy;
+        const float b = dx * vx + dy * vy;
+        // Not closing in: the gap only grows.
+        if (a == 0.0f || b >= 0.0f) return NoContact;
+
+        const float discriminant = b * b - a * c;
+        if (discriminant < 0.0f) return NoContact;
+
+        const float t = (-b - std::sqrt(discriminant)) / a;
+        return t <= 1.0f ? t : NoContact;
+    }
+
+    Path activePath() noexcept
+    {
+        return activePathRef().load();
+    }
+
+    bool setActivePath(Path path) noexcept
+    {
+        if (!Kinematics::isSupported(path)) return false;
+
+        activePathRef().store(path);
+        return true;
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ColliderBatch.h"
+#include "Kinematics.h"
+
+// Circle-circle overlap tests over Structure-of-Arrays circles,
+//
+//     dx*dx + dy*dy <= (r1 + r2)^2
+//
+// several circles per instruction, writing the indices that overlap in
+// ascending order. Paths and CPU detection are Kinematics' (scalar, SSE2,
+// AVX2, picked at runtime). Every path performs the same single-precision
+// operations in the same order, never fused, so all of them report exactly
+// the hits of the scalar path. FMA contraction is kept off for
+// Narrowphase.cpp, as for Kinematics.cpp.
+//
+// hits must have room for count entries; each function returns how many it
+// wrote.
+namespace Narrowphase
+{
+    using Path = Kinematics::Path;
+
+    // Query circle against circles [0, count); hits are indices.
+    std::size_t overlapCircle(float x, float y, float radius, const float* posX, const float* posY, const float* radii,
+        std::size_t count, std::uint32_t* hits);
+
+    // Query circle against the circles named by candidates, e.g. from a
+    // broadphase query; hits are the overlapping candidates' values.
+    std::size_t overlapCandidates(float x, float y, float radius, const float* posX, const float* posY, const float* radii,
+        const std::uint32_t* candidates, std::size_t count, std::uint32_t* hits);
+
+    // Both circles of each pair from the same arrays, e.g. from findPairs;
+    // hits are the overlapping pairs. Scalar whatever the active path: with
+    // two scattered circles per test, filling the lanes cost more than the
+    // vector test saved (Benchmarks/NarrowphaseBench.cpp).
+    std::size_t overlapPairs(const float* posX, const float* posY, const float* radii,
+        const ColliderPair* pairs, std::size_t count, ColliderPair* hits);
+
+    // Returned by sweptContact when the circles never touch.
+    constexpr float NoContact = -1.0f;
+
+    // Two circles moving in straight lines over one step, one from (x0, y0)
+    // to (x1, y1), the other from (otherX0, otherY0) to (otherX1, otherY1),
+    // touching when their centres are within reach. Returns the fraction of
+    // the step in [0, 1] at which they first touch (0 if they start
+    // overlapping), or NoContact. Unlike the overlap tests this catches
+    // circles that pass through each other between the two positions, so
+    // hits do not depend on the step length.
+    float sweptContact(float x0, float y0, float x1, float y1,
+        float otherX0, float otherY0, float otherX1, float otherY1, float reach);
+
+    // Path used by the functions above: the widest supported one unless
+    // overridden. Returns false, leaving it alone, if path is not supported.
+    Path activePath() noexcept;
+    bool setActivePath(Path path) noexcept;
+
+    // Filters candidates down to the circles of colliders that overlap the
+    // query circle.
+    inline void filterCandidates(const ColliderBatch& colliders, float x, float y, float radius,
+        const std::vector<std::uint32_t>& candidates, std::vector<std::uint32_t>& hits)
+    {
+        hits.resize(candidates.size());
+        hits.resize(overlapCandidates(x, y, radius, colliders.posX.data(), colliders.posY.data(), colliders.radius.data(),
+            candidates.data(), candidates.size(), hits.data()));
+    }
+
+    // Filters candidate pairs down to those whose circles overlap.
+    inline void filterPairs(const ColliderBatch& colliders, const std::vector<ColliderPair>& pairs, std::vector<ColliderPair>& hits)
+    {
+        hits.resize(pairs.size());
+        hits.resize(overlapPairs(colliders.posX.data(), colliders.posY.data(), colliders.radius.data(),
+            pairs.data(), pairs.size(), hits.data()));
+    }
+}
@@ -1,39 +1,412 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+// Growth policies decide how many objects to add when acquire() finds the pool
+// empty. Returning 0 means the pool is exhausted.
+
+struct FixedCapacity
+{
+    size_t nextChunkSize(size_t /*capacity*/) const noexcept { return 0; }
+};
+
+struct ChunkedGrowth
+{
+    size_t chunkSize{ 64 };
+    size_t maxCapacity{ static_cast<size_t>(-1) };
+
+    size_t nextChunkSize(size_t capacity) const noexcept {
+        return capacity >= maxCapacity ? 0 : std::min(chunkSize, maxCapacity - capacity);
+    }
+};
+
+// Eviction policies pick an active object to recycle once the pool is
+// exhausted. The victim is reused in place and handed out again by acquire().
+
+struct NoEviction
+{
+    template <typename Pool>
+    typename Pool::ObjectType* selectVictim(const Pool& /*pool*/) const { return nullptr; }
+};
+
+struct EvictOldest
+{
+    template <typename Pool>
+    typename Pool::ObjectType* selectVictim(const Pool& pool) const { return pool.oldestActive(); }
+};
+
+// O(n) scan over the active list; priorities may change every tick, so no
+// ordering is maintained between evictions.
+template <typename PriorityFn>
+struct EvictLowestPriority
+{
+    PriorityFn priority;
+
+    template <typename Pool>
+    typename Pool::ObjectType* selectVictim(const Pool& pool) const {
+        typename Pool::ObjectType* victim = nullptr;
+        for (auto* obj : pool.getActiveObjects()) {
+            if (!obj->isPoolActive()) continue;
+            if (!victim || priority(*obj) < priority(*victim)) victim = obj;
+        }
+        return victim;
+    }
+};
+
+template <typename T, typename GrowthPolicy = FixedCapacity, typename EvictionPolicy = NoEviction>
+class ObjectPool;
+
+// Pooled types may define onPoolAcquire() and onPoolRelease() to set up and
+// tear down per-use state. The pool calls them whenever an object is handed
+// out or taken back, including by releaseAll() and eviction.
+template <typename T, typename = void>
+struct HasPoolHooks : std::false_type {};
+
 template <typename T>
+struct HasPoolHooks<T, std::void_t<decltype(std::declval<T&>().onPoolAcquire()), decltype(std::declval<T&>().onPoolRelease())>>
+    : std::true_type {};
+
+// Intrusive bookkeeping for ObjectPool. Every pooled object remembers its slot
+// in the pool's active list, so release() can swap-remove in O(1), its index
+// in the pool's slab storage, which handles refer to, and its neighbours in
+// acquisition order for eviction.
+class Pooled
+{
+public:
+    static constexpr std::size_t InvalidSlot = static_cast<std::size_t>(-1);
+
+    bool isPoolActive() const noexcept { return poolSlot != InvalidSlot && !poolReleasePending; }
+
+private:
+    template <typename, typename, typename> friend class ObjectPool;
+
+    std::size_t poolSlot{ InvalidSlot };
+    std::uint32_t poolIndex{ 0 };
+    bool poolReleasePending{ false };
+    bool poolAcquiredLate{ false };
+    Pooled* poolOlder{ nullptr };
+    Pooled* poolNewer{ nullptr };
+};
+
+// Weak reference to a pooled object. The generation is bumped every time the
+// object is released, so a handle kept past release() no longer resolves.
+struct PoolHandle
+{
+    static constexpr std::uint32_t InvalidIndex = static_cast<std::uint32_t>(-1);
+
+    std::uint32_t index{ InvalidIndex };
+    std::uint32_t generation{ 0 };
+
+    bool isValid() const noexcept { return index != InvalidIndex; }
+
+    friend bool operator==(const PoolHandle& a, const PoolHandle& b) noexcept { return a.index == b.index && a.generation == b.generation; }
+    friend bool operator!=(const PoolHandle& a, const PoolHandle& b) noexcept { return !(a == b); }
+};
+
+template <typename T, typename GrowthPolicy, typename EvictionPolicy>
 class ObjectPool
 {
+public:
+    using ObjectType = T;
+    using Handle = PoolHandle;
+    using ExhaustedCallback = std::function<void(size_t capacity)>;
+    using EvictCallback = std::function<void(T* victim)>;
+    // Constructs a T in the raw storage at where, for types that are not
+    // default constructible. Called for every object when its chunk is added.
+    using Constructor = std::function<void(void* where)>;
+
+    static constexpr std::size_t ChunkAlignment = alignof(T) > 64 ? alignof(T) : 64;
+
 private:
+    struct ChunkDeleter
+    {
+        void operator()(unsigned char* p) const noexcept { ::operator delete(p, std::align_val_t{ ChunkAlignment }); }
+    };
+    using Chunk = std::unique_ptr<unsigned char, ChunkDeleter>;
+
+    // Objects live in a few contiguous, cache-line aligned chunks and never
+    // move, so pointers handed out by acquire() stay valid for the pool's life.
+    std::vector<Chunk> chunks;
+    std::vector<T*> slots;
+    std::vector<std::uint32_t> generations;
+
     std::vector<T*> active;
     std::vector<T*> inactive;
+    std::vector<T*> pendingRelease;
+    // Acquired or evicted during a traversal, so skipped until it finishes.
+    std::vector<T*> acquiredLate;
+    int iterationDepth{};
+
+    Pooled* oldest{ nullptr };
+    Pooled* newest{ nullptr };
+
+    GrowthPolicy growth;
+    EvictionPolicy eviction;
+    ExhaustedCallback onExhausted;
+    EvictCallback onEvict;
+    Constructor construct;
 
 public:
-    ObjectPool(size_t size = 200) {
-        inactive.reserve(size);
-        active.reserve(size);
-        for (size_t i = 0; i < size; ++i) {
-            inactive.emplace_back(new T());
-        }
+    ObjectPool(size_t size = 200, GrowthPolicy growthPolicy = GrowthPolicy{}, EvictionPolicy evictionPolicy = EvictionPolicy{},
+        Constructor constructor = Constructor{})
+        : growth(std::move(growthPolicy)), eviction(std::move(evictionPolicy)), construct(std::move(constructor)) {
+        static_assert(std::is_base_of_v<Pooled, T>, "ObjectPool<T> requires T to derive from Pooled");
+
+        addChunk(size);
     }
 
+    ~ObjectPool() {
+        for (T* obj : slots) obj->~T();
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    // Called every time acquire() finds no free object and the growth policy
+    // refuses to grow, before eviction is attempted.
+    void setExhaustedCallback(ExhaustedCallback callback) { onExhausted = std::move(callback); }
+
+    // Called with an object that is about to be recycled by the eviction
+    // policy, so its current user can let go of it.
+    void setEvictCallback(EvictCallback callback) { onEvict = std::move(callback); }
+
     T* acquire() {
-        if (inactive.empty()) return nullptr;
+        if (inactive.empty()) addChunk(growth.nextChunkSize(slots.size()));
+
+        if (inactive.empty()) {
+            if (onExhausted) onExhausted(slots.size());
+            return evict();
+        }
+
         T* obj = inactive.back();
         inactive.pop_back();
+        obj->poolSlot = active.size();
         active.push_back(obj);
+        linkNewest(obj);
+        markIfLate(obj);
+        notifyAcquire(obj);
         return obj;
     }
 
+    // O(1). While forEachActive() is running the release is deferred until the
+    // outermost traversal finishes; the object is skipped by that traversal.
     void release(T* obj) {
-        auto it = std::find(active.begin(), active.end(), obj);
-        if (it != active.end()) {
-            active.erase(it);
+        if (!owns(obj)) return;
+
+        if (iterationDepth > 0) {
+            if (!obj->poolReleasePending) {
+                obj->poolReleasePending = true;
+                pendingRelease.push_back(obj);
+            }
+            return;
+        }
+
+        releaseNow(obj);
+    }
+
+    void releaseAll() {
+        if (iterationDepth > 0) {
+            for (T* obj : active) release(obj);
+            return;
+        }
+
+        for (T* obj : active) {
+            notifyRelease(obj);
+            obj->poolSlot = Pooled::InvalidSlot;
+            obj->poolOlder = nullptr;
+            obj->poolNewer = nullptr;
+            ++generations[obj->poolIndex];
             inactive.push_back(obj);
         }
+        active.clear();
+        oldest = nullptr;
+        newest = nullptr;
     }
 
-    std::vector<T*>& getActiveObjects() { return active; }
-};
+    // Visits every active object in slab order, so the walk goes forwards
+    // through memory whatever order objects were acquired and released in;
+    // the order is otherwise unspecified. It costs O(capacity), not
+    // O(activeCount()). fn may acquire or release objects of this pool:
+    // released objects are not visited again, objects acquired during the
+    // traversal are first visited by the next one. If fn returns bool,
+    // returning false stops the traversal.
+    template <typename Fn>
+    void forEachActive(Fn&& fn) {
+        ++iterationDepth;
 
+        // Chunks added by fn hold only free or newly acquired objects.
+        const size_t count = slots.size();
+        for (size_t i = 0; i < count; ++i) {
+            T* obj = slots[i];
+            if (obj->poolSlot == Pooled::InvalidSlot || obj->poolReleasePending || obj->poolAcquiredLate) continue;
+
+            if constexpr (std::is_same_v<std::invoke_result_t<Fn&, T*>, bool>) {
+                if (!fn(obj)) break;
+            }
+            else {
+                fn(obj);
+            }
+        }
+
+        if (--iterationDepth == 0) {
+            for (T* obj : acquiredLate) obj->poolAcquiredLate = false;
+            acquiredLate.clear();
+            flushPendingReleases();
+        }
+    }
+
+    bool owns(const T* obj) const noexcept {
+        return obj && obj->poolSlot < active.size() && active[obj->poolSlot] == obj;
+    }
+
+    Handle handleOf(const T* obj) const noexcept {
+        if (!owns(obj) || obj->poolReleasePending) return Handle{};
+        return Handle{ obj->poolIndex, generations[obj->poolIndex] };
+    }
+
+    // Returns nullptr if the handle is invalid or its object was released since.
+    T* get(Handle handle) const noexcept {
+        if (handle.index >= slots.size() || generations[handle.index] != handle.generation) return nullptr;
+        T* obj = slots[handle.index];
+        return obj->isPoolActive() ? obj : nullptr;
+    }
+
+    // Least recently acquired object that is not pending release.
+    T* oldestActive() const noexcept {
+        for (Pooled* p = oldest; p; p = p->poolNewer) {
+            if (!p->poolReleasePending) return static_cast<T*>(p);
+        }
+        return nullptr;
+    }
+
+    size_t capacity() const noexcept { return slots.size(); }
+    size_t activeCount() const noexcept { return active.size(); }
+
+    // Direct view of the active list, in no particular order: release() moves
+    // the last entry into the freed place, so after a few releases it no
+    // longer follows the slab. Do not release while iterating it; use
+    // forEachActive() for traversals that may release or want slab order.
+    const std::vector<T*>& getActiveObjects() const { return active; }
+
+private:
+    void addChunk(size_t count) {
+        if (count == 0) return;
+
+        chunks.reserve(chunks.size() + 1);
+        slots.reserve(slots.size() + count);
+        generations.reserve(generations.size() + count);
+        inactive.reserve(inactive.size() + count);
+        active.reserve(slots.size() + count);
+        pendingRelease.reserve(slots.size() + count);
+        acquiredLate.reserve(slots.size() + count);
+
+        Chunk chunk(static_cast<unsigned char*>(::operator new(count * sizeof(T), std::align_val_t{ ChunkAlignment })));
+        T* first = reinterpret_cast<T*>(chunk.get());
+
+        size_t constructed = 0;
+        try {
+            for (; constructed < count; ++constructed) {
+                if (construct) construct(first + constructed);
+                else defaultConstruct(first + constructed);
+            }
+        }
+        catch (...) {
+            while (constructed > 0) first[--constructed].~T();
+            throw;
+        }
+
+        chunks.push_back(std::move(chunk));
+
+        for (size_t i = 0; i < count; ++i) {
+            first[i].poolIndex = static_cast<std::uint32_t>(slots.size());
+            slots.push_back(first + i);
+            generations.push_back(0);
+        }
+
+        // Hand out the lowest addresses first so the active set walks the slab forwards.
+        for (size_t i = count; i > 0; --i) inactive.push_back(first + i - 1);
+    }
+
+    // Recycles an active object in place: it keeps its active slot, gets a new
+    // generation and becomes the newest object.
+    T* evict() {
+        T* victim = eviction.selectVictim(*this);
+        if (!owns(victim) || victim->poolReleasePending) return nullptr;
+
+        if (onEvict) onEvict(victim);
+        notifyRelease(victim);
+
+        ++generations[victim->poolIndex];
+        unlink(victim);
+        linkNewest(victim);
+        markIfLate(victim);
+        notifyAcquire(victim);
+        return victim;
+    }
+
+    void markIfLate(T* obj) {
+        if (iterationDepth == 0 || obj->poolAcquiredLate) return;
+        obj->poolAcquiredLate = true;
+        acquiredLate.push_back(obj);
+    }
+
+    static void defaultConstruct(T* where) {
+        if constexpr (std::is_default_constructible_v<T>) new (where) T();
+        else throw std::logic_error("ObjectPool: T is not default constructible and no Constructor was given");
+    }
+
+    void linkNewest(Pooled* p) noexcept {
+        p->poolOlder = newest;
+        p->poolNewer = nullptr;
+        if (newest) newest->poolNewer = p;
+        else oldest = p;
+        newest = p;
+    }
+
+    void unlink(Pooled* p) noexcept {
+        if (p->poolOlder) p->poolOlder->poolNewer = p->poolNewer;
+        else oldest = p->poolNewer;
+        if (p->poolNewer) p->poolNewer->poolOlder = p->poolOlder;
+        else newest = p->poolOlder;
+        p->poolOlder = nullptr;
+        p->poolNewer = nullptr;
+    }
+
+    void notifyAcquire(T* obj) {
+        if constexpr (HasPoolHooks<T>::value) obj->onPoolAcquire();
+    }
+
+    void notifyRelease(T* obj) {
+        if constexpr (HasPoolHooks<T>::value) obj->onPoolRelease();
+    }
+
+    void releaseNow(T* obj) {
+        notifyRelease(obj);
+
+        const size_t slot = obj->poolSlot;
+        T* last = active.back();
+        active[slot] = last;
+        last->poolSlot = slot;
+        active.pop_back();
+        unlink(obj);
+
+        obj->poolSlot = Pooled::InvalidSlot;
+        obj->poolReleasePending = false;
+        ++generations[obj->poolIndex];
+        inactive.push_back(obj);
+    }
+
+    void flushPendingReleases() {
+        for (T* obj : pendingRelease) releaseNow(obj);
+        pendingRelease.clear();
+    }
+};
@@ -1,77 +1,62 @@
 #include "Player.h"
-#include <SFML/Graphics/RenderTarget.hpp>
-#include <SFML/Window/Keyboard.hpp>
+#include <SFML/System/Angle.hpp>
 #include <algorithm>
-#include "EventBus.h"
-#include "InputEvents.h"
+#include <cmath>
+#include "ComponentRegistry.h"
+#include "World.h"
 
-Player::Player() : Entity(0.0f),
+Player::Player(World& world) :
+	world(world),
 	drag(100.0f),
 	accelerationSpeed(400.0f),
 	maxSpeed(400.0f),
 	turnRate(200.0f)
 {
-	shape.setFillColor(sf::Color::White);
-	shape.setRadius(30.0f);
-	shape.setPointCount(3);
-	shape.setOrigin({ shape.getRadius(), shape.getRadius() });
-
-	headingShape.setFillColor(sf::Color::Black);
-	headingShape.setRadius(10.0f);
-	headingShape.setPointCount(3);
-	headingShape.setOrigin({ headingShape.getRadius(), headingShape.getRadius() + 7.0f });
-	headingShape.setPosition(shape.getPosition());
-
-	keySubId = GlobalEventBus().subscribe<KeyEvent>(
-		[this](const KeyEvent& ev)
-		{
-			using KE = KeyEvent;
-			const int keyUp = static_cast<int>(sf::Keyboard::Key::Up);
-			const int keyDown = static_cast<int>(sf::Keyboard::Key::Down);
-			const int keyLeft = static_cast<int>(sf::Keyboard::Key::Left);
-			const int keyRight = static_cast<int>(sf::Keyboard::Key::Right);
-			const int keyW = static_cast<int>(sf::Keyboard::Key::W);
-			const int keyS = static_cast<int>(sf::Keyboard::Key::S);
-			const int keyA = static_cast<int>(sf::Keyboard::Key::A);
-			const int keyD = static_cast<int>(sf::Keyboard::Key::D);
-
-			if (ev.action == KE::Action::Press)
-			{
-				if (ev.key == keyUp || ev.key == keyW) { thrust = 1.0f; }
-				if (ev.key == keyDown || ev.key == keyS) { thrust = -1.0f; }
-				if (ev.key == keyLeft || ev.key == keyA) { turnDirection = -1.0f; }
-				if (ev.key == keyRight || ev.key == keyD) { turnDirection = 1.0f; }
-			}
-			else // Release
-			{
-				if (ev.key == keyUp || ev.key == keyW) { if (thrust > 0.0f) thrust = 0.0f; }
-				if (ev.key == keyDown || ev.key == keyS) { if (thrust < 0.0f) thrust = 0.0f; }
-				if (ev.key == keyLeft || ev.key == keyA) { if (turnDirection < 0.0f) turnDirection = 0.0f; }
-				if (ev.key == keyRight || ev.key == keyD) { if (turnDirection > 0.0f) turnDirection = 0.0f; }
-			}
-		});
+	ComponentRegistry& registry = world.components;
+	id = registry.createEntity();
+	registry.transforms.add(id);
+	registry.velocities.add(id);
+	registry.colliders.add(id, Collider{ Radius });
+	registry.renderables.add(id, Renderable{ Appearance::Player });
 }
 
 Player::~Player()
 {
-	if (keySubId) GlobalEventBus().unsubscribe<KeyEvent>(keySubId);
-	if (mouseSubId) GlobalEventBus().unsubscribe<MouseEvent>(mouseSubId);
+	world.components.destroyEntity(id);
 }
 
-void Player::update(float deltaTime)
+void Player::steer(float deltaTime)
 {
-	rotate(sf::degrees(turnDirection * turnRate * deltaTime));
+	ComponentRegistry& registry = world.components;
+
+	sf::Angle rotation;
+	registry.transforms.write(id, [&](Transform& transform)
+	{
+		rotation = (sf::degrees(transform.rotation) + sf::degrees(turnDirection * turnRate * deltaTime)).wrapUnsigned();
+		transform.rotation = rotation.asDegrees();
+	});
+
+	registry.velocities.write(id, [&](Velocity& velocity)
+	{
+		const float heading = rotation.asRadians() + sf::degrees(-90.0f).asRadians();
+		velocity.direction = sf::Vector2f(std::cos(heading), std::sin(heading));
+		velocity.speed = std::clamp(velocity.speed + thrust * accelerationSpeed * deltaTime - drag * deltaTime, 0.0f, maxSpeed);
+	});
+}
 
-	float rotation = getRotation().asRadians() + sf::degrees(-90.0f).asRadians();
-	direction = sf::Vector2f(cos(rotation), sin(rotation));
-	speed = std::clamp(speed + thrust * accelerationSpeed * deltaTime - drag * deltaTime, 0.0f, maxSpeed);
-	move(direction * speed * deltaTime);
+void Player::reset(const sf::Vector2f& position)
+{
+	ComponentRegistry& registry = world.components;
+	registry.transforms.add(id, Transform{ position, 0.0f, position });
+	registry.velocities.write(id, [](Velocity& velocity) { velocity.speed = 0.0f; });
 }
 
-void Player::draw(sf::RenderTarget& target, sf::RenderStates states) const
+sf::Vector2f Player::getPosition() const
 {
-	Entity::draw(target, states);
+	return world.components.transforms.get(id).position;
+}
 
-	states.transform = getTransform();
-	target.draw(headingShape, states);
+void Player::setPosition(const sf::Vector2f& position)
+{
+	world.components.transforms.write(id, [&](Transform& transform) { transform.position = position; });
 }
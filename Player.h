@@ -1,35 +1,47 @@
 #pragma once
 
-#include "Entity.h"
-#include "EventBus.h"
-#include "InputEvents.h"
+#include <SFML/System/Vector2.hpp>
+#include "ComponentManager.h"
 
-class Player : public Entity
+class World;
+
+// The player's state lives in components (Transform, Velocity, Collider,
+// Renderable); this object owns the entity and how it handles.
+class Player
 {
 public:
-    Player();
+    static constexpr float Radius = 30.0f;
+
+    explicit Player(World& world);
     ~Player();
 
-    virtual void update(float deltaTime) override;
+    Player(const Player&) = delete;
+    Player& operator=(const Player&) = delete;
+
+    // Turns and sets the velocity from the current thrust and turn direction.
+    // Simulation::moveEntities then moves the player with everything else.
+    void steer(float deltaTime);
+
+    // At rest at position, facing up.
+    void reset(const sf::Vector2f& position);
 
     void setTurnDirection(float newTurnDirection) { turnDirection = newTurnDirection; }
     void setThrust(float newThrust) { thrust = newThrust; }
 
-    float getRadius() { return shape.getRadius(); }
+    EntityId getId() const noexcept { return id; }
 
-protected:
-    virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    sf::Vector2f getPosition() const;
+    void setPosition(const sf::Vector2f& position);
+
+    float getRadius() const noexcept { return Radius; }
 
 private:
-    sf::CircleShape headingShape;
+    World& world;
+    EntityId id{ 0 };
     float drag;
     float thrust{};
     float accelerationSpeed;
     float maxSpeed;
     float turnDirection{};
     float turnRate;
-
-    EventBus::HandlerId keySubId{0};
-    EventBus::HandlerId mouseSubId{0};
 };
-
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+// Per-world random numbers for gameplay. std::minstd_rand is fully specified
+// by the standard, unlike rand() and the std distributions, so a seed plus
+// the recorded input reproduce a session on any platform. Callers reduce
+// next() with % as they did rand().
+class Random
+{
+public:
+    explicit Random(std::uint32_t seed = 1) : engine_(seed) {}
+
+    void seed(std::uint32_t seed) { engine_.seed(seed); }
+
+    // In [0, 2^31 - 3]: minstd_rand yields [1, 2^31 - 2].
+    int next() { return static_cast<int>(engine_() - 1); }
+
+private:
+    std::minstd_rand engine_;
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// Sequence counter for optimistic reads.
+//
+// A writer makes the count odd while it modifies the data the counter guards
+// and even again afterwards. A reader notes the count, copies the data and
+// keeps the copy only if the count is unchanged. Readers just load the
+// counter, so they never write shared memory and do not pull its cache line
+// away from other cores.
+//
+// Writers must already be serialized among themselves (e.g. by a mutex). The
+// guarded data is read while it may be changing, so it must be plain values
+// that are not used until validate() has succeeded.
+class SeqCounter
+{
+public:
+    void beginWrite() noexcept
+    {
+        seq_.store(seq_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void endWrite() noexcept
+    {
+        seq_.store(seq_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Waits out a write in progress and returns the count to validate against.
+    std::uint32_t beginRead() const noexcept
+    {
+        std::uint32_t seq = seq_.load(std::memory_order_acquire);
+        while (seq & 1u)
+        {
+            std::this_thread::yield();
+            seq = seq_.load(std::memory_order_acquire);
+        }
+        return seq;
+    }
+
+    // True if no write started since beginRead() returned start.
+    bool validate(std::uint32_t start) const noexcept
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return seq_.load(std::memory_order_relaxed) == start;
+    }
+
+private:
+    std::atomic<std::uint32_t> seq_{ 0 };
+};
+
+// One counter per cache line, for arrays of counters that guard neighbouring
+// stripes of data written by different threads.
+struct alignas(64) PaddedSeqCounter : SeqCounter
+{
+};
+
+template <typename Counter>
+class SeqWriteGuard
+{
+public:
+    explicit SeqWriteGuard(Counter& counter) noexcept : counter_(counter) { counter_.beginWrite(); }
+    ~SeqWriteGuard() { counter_.endWrite(); }
+
+    SeqWriteGuard(const SeqWriteGuard&) = delete;
+    SeqWriteGuard& operator=(const SeqWriteGuard&) = delete;
+
+private:
+    Counter& counter_;
+};
+
+// Stands in for SeqWriteGuard where nothing reads concurrently.
+template <typename Counter>
+class NullSeqWriteGuard
+{
+public:
+    explicit NullSeqWriteGuard(Counter&) noexcept {}
+    // User-provided, like SeqWriteGuard's, so a guard local does not warn as unused.
+    ~NullSeqWriteGuard() {}
+
+    NullSeqWriteGuard(const NullSeqWriteGuard&) = delete;
+    NullSeqWriteGuard& operator=(const NullSeqWriteGuard&) = delete;
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <SFML/System/Time.hpp>
+
+// Stopwatch driven by simulation time instead of the wall clock, so gameplay
+// timers behave identically when a session is replayed at any speed. Mirrors
+// the subset of sf::Clock the game uses; advance() is called once per tick.
+class SimClock
+{
+public:
+    void advance(float deltaTime) noexcept
+    {
+        if (running) elapsed += deltaTime;
+    }
+
+    sf::Time getElapsedTime() const noexcept { return sf::seconds(elapsed); }
+    bool isRunning() const noexcept { return running; }
+
+    void start() noexcept { running = true; }
+    void stop() noexcept { running = false; }
+
+    sf::Time restart() noexcept
+    {
+        const sf::Time previous = getElapsedTime();
+        elapsed = 0.0f;
+        running = true;
+        return previous;
+    }
+
+private:
+    float elapsed{};
+    bool running{ true };
+};
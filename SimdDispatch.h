@@ -0,0 +1,22 @@
+#pragma once
+
+// x86 detection and per-function target attributes for the translation units
+// that pick a SIMD path at runtime (Kinematics.cpp, Narrowphase.cpp). Include
+// it from .cpp files only: it pulls in the intrinsics headers.
+//
+// SIMD_X86 is defined on x86 and x64. SIMD_TARGET_SSE2 and SIMD_TARGET_AVX2
+// mark functions that use those instruction sets, so the rest of the file can
+// be compiled for the baseline CPU.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// MSVC accepts intrinsics of any instruction set without per-function flags.
+#define SIMD_TARGET_SSE2
+#define SIMD_TARGET_AVX2
+#else
+#define SIMD_TARGET_SSE2 __attribute__((target("sse2")))
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
@@ -0,0 +1,501 @@
+#include "Simulation.h"
+#include "Asteroid.h"
+#include "Bullet.h"
+#include "ComponentRegistry.h"
+#include "Narrowphase.h"
+#include "World.h"
+#include <SFML/System/Angle.hpp>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+Simulation::Simulation(World& world, const sf::Vector2u& arenaSize, float timeStep) :
+    world(world),
+    arenaSize(arenaSize),
+    timeStep(timeStep),
+    player(world),
+    zone(world),
+    timeToCompleteZone(20.0f),
+    shootCooldown(0.25f),
+    asteroidCooldown(1.5f),
+    gameZoneMargin(100.0f),
+    pointsPerAsteroidLevel(5),
+    pointsPerZoneComplete(50)
+{
+}
+
+void Simulation::start(std::uint32_t seed)
+{
+    world.random.seed(seed);
+    tick = 0;
+
+    state = State::Running;
+    zonesCompleted = 0;
+    score = 0;
+    isPlayerInsideZone = false;
+    player.reset(sf::Vector2f(arenaSize) / 2.0f);
+
+    world.bulletPool.releaseAll();
+    world.asteroidPool.releaseAll();
+
+    shootTimer.restart();
+    asteroidTimer.restart();
+    playtimeTimer.restart();
+    zoneTimer.restart();
+    zoneTimer.stop();
+
+    spawnZone();
+}
+
+// Shooting comes first: the bullet leaves from where the player was at the
+// end of the previous tick and then moves with everything else.
+void Simulation::step(const InputState& input)
+{
+    if (state != State::Running) return;
+
+    if (input.fire) tryShoot(input.aim);
+
+    ++tick;
+    advanceTimers(timeStep);
+
+    player.setThrust(input.thrust);
+    player.setTurnDirection(input.turn);
+    player.steer(timeStep);
+    moveEntities(timeStep);
+    world.asteroids.gatherPositions(asteroidStartX, asteroidStartY);
+    world.asteroids.updateAll(timeStep);
+    gatherAsteroids();
+    if (asteroidCollisions) collideAsteroids();
+
+    isPlayerInsideZone = intersects(player.getId(), zone.getId());
+    if (isPlayerInsideZone)
+    {
+        if (!zoneTimer.isRunning())
+        {
+            zoneTimer.restart();
+        }
+
+        if (zoneTimer.getElapsedTime().asSeconds() >= timeToCompleteZone)
+        {
+            ++zonesCompleted;
+            score += pointsPerZoneComplete;
+            spawnZone();
+        }
+    }
+    else
+    {
+        if (zoneTimer.isRunning())
+        {
+            zoneTimer.stop();
+        }
+    }
+    if (state != State::Running) return;
+
+    constrainPlayerMovement();
+
+    checkCollisions();
+    if (state != State::Running) return;
+
+    trySpawnAsteroid();
+}
+
+void Simulation::advanceTimers(float deltaTime)
+{
+    zoneTimer.advance(deltaTime);
+    playtimeTimer.advance(deltaTime);
+    shootTimer.advance(deltaTime);
+    asteroidTimer.advance(deltaTime);
+}
+
+// Everything with a Velocity (bullets, the player, the zone) moves in one
+// pass: rotations advance while positions are gathered into columns for the
+// SIMD kernel, then positions are written back. Both passes walk the
+// velocities and transforms side by side (forEachJoined), with no lookups.
+void Simulation::moveEntities(float deltaTime)
+{
+    ComponentRegistry& registry = world.components;
+
+    movementBatch.resize(registry.velocities.size());
+
+    std::size_t count = 0;
+    registry.velocities.forEachJoined(registry.transforms, [&](EntityId, const Velocity& velocity, Transform& transform)
+    {
+        if (velocity.angularSpeed != 0.0f)
+        {
+            transform.rotation = (sf::degrees(transform.rotation) + sf::degrees(velocity.angularSpeed * deltaTime)).wrapUnsigned().asDegrees();
+        }
+
+        transform.previousPosition = transform.position;
+        movementBatch.posX[count] = transform.position.x;
+        movementBatch.posY[count] = transform.position.y;
+        movementBatch.dirX[count] = velocity.direction.x;
+        movementBatch.dirY[count] = velocity.direction.y;
+        movementBatch.speed[count] = velocity.speed;
+        ++count;
+    });
+
+    movementBatch.resize(count);
+    movementBatch.integrate(deltaTime);
+
+    std::size_t i = 0;
+    registry.velocities.forEachJoined(registry.transforms, [&](EntityId, const Velocity&, Transform& transform)
+    {
+        transform.position = { movementBatch.posX[i], movementBatch.posY[i] };
+        ++i;
+    });
+}
+
+// Contacts are resolved in index order rather than the order the sweep found
+// them, so the outcome does not depend on how the sweep's order evolved.
+// Resolving updates the gathered colliders too, so checkCollisions reads
+// them as they are.
+void Simulation::collideAsteroids()
+{
+    asteroidSweep.update(asteroidColliders);
+
+    asteroidPairs.clear();
+    asteroidSweep.findPairs(asteroidPairs);
+    Narrowphase::filterPairs(asteroidColliders, asteroidPairs, asteroidContacts);
+    if (asteroidContacts.empty()) return;
+
+    std::sort(asteroidContacts.begin(), asteroidContacts.end(), [](const ColliderPair& a, const ColliderPair& b)
+    {
+        return a.first != b.first ? a.first < b.first : a.second < b.second;
+    });
+    world.asteroids.resolveContacts(Span<const ColliderPair>(asteroidContacts), asteroidColliders);
+}
+
+void Simulation::checkCollisions()
+{
+    ComponentRegistry& registry = world.components;
+
+    // Gathered by step once the asteroids have moved.
+    indexAsteroids();
+
+    world.bulletPool.forEachActive([&](Bullet* bullet)
+    {
+        const Transform transform = registry.transforms.get(bullet->getId());
+        if (isOutOfBounds(transform.position))
+        {
+            world.bulletPool.release(bullet);
+            return;
+        }
+
+        const float bulletRadius = registry.colliders.get(bullet->getId()).radius;
+
+        const std::uint32_t hit = firstAsteroidHit(transform.previousPosition, transform.position, bulletRadius);
+        if (hit == NoCollider) return;
+
+        Asteroid* asteroid = asteroidOwners[hit];
+        score += pointsPerAsteroidLevel * asteroid->getLevel();
+
+        world.bulletPool.release(bullet);
+
+        pendingSplits.push_back(hit);
+    });
+
+    // Bullets are visited in the pool's slab order, which depends on what
+    // earlier sessions did with the pool; splits draw random numbers, so they
+    // run in dense index order instead. A second hit in the same tick scores
+    // but does not split again.
+    std::sort(pendingSplits.begin(), pendingSplits.end());
+    pendingSplits.erase(std::unique(pendingSplits.begin(), pendingSplits.end()), pendingSplits.end());
+
+    // Splits move, shrink, release and add asteroids: gather again.
+    if (!pendingSplits.empty()) splitAndRegatherAsteroids();
+
+    const sf::Vector2f playerFrom = registry.transforms.get(player.getId()).previousPosition;
+    if (firstAsteroidHit(playerFrom, player.getPosition(), player.getRadius()) != NoCollider)
+    {
+        finish(State::Lost);
+        return;
+    }
+
+    for (std::size_t i = 0; i < asteroidColliders.size(); ++i)
+    {
+        if (isOutOfBounds({ asteroidColliders.posX[i], asteroidColliders.posY[i] }))
+        {
+            world.asteroidPool.release(asteroidOwners[i]);
+        }
+    }
+}
+
+void Simulation::gatherAsteroids()
+{
+    world.asteroids.gatherColliders(asteroidColliders, asteroidOwners);
+
+    const std::size_t started = std::min(asteroidStartX.size(), asteroidColliders.size());
+    std::copy_n(asteroidStartX.begin(), started, asteroidColliders.startX.begin());
+    std::copy_n(asteroidStartY.begin(), started, asteroidColliders.startY.begin());
+}
+
+// Releasing an asteroid moves the last one into its dense index, so starts
+// are matched up by owner. Split children start where they are, even when
+// the pool hands out an Asteroid released by the same splits.
+void Simulation::splitAndRegatherAsteroids()
+{
+    const auto byOwner = [](const AsteroidStart& a, const AsteroidStart& b) { return std::less<Asteroid*>()(a.owner, b.owner); };
+
+    asteroidStarts.clear();
+    for (std::size_t i = 0; i < asteroidColliders.size(); ++i)
+    {
+        asteroidStarts.push_back(AsteroidStart{ asteroidOwners[i], asteroidColliders.startX[i], asteroidColliders.startY[i] });
+    }
+    std::sort(asteroidStarts.begin(), asteroidStarts.end(), byOwner);
+
+    splitPendingAsteroids();
+
+    splitChildren.clear();
+    for (const AsteroidComponentManager::SplitDesc& split : splitBatch)
+    {
+        if (split.child) splitChildren.push_back(split.child);
+    }
+    std::sort(splitChildren.begin(), splitChildren.end());
+
+    world.asteroids.gatherColliders(asteroidColliders, asteroidOwners);
+    for (std::size_t i = 0; i < asteroidColliders.size(); ++i)
+    {
+        if (std::binary_search(splitChildren.begin(), splitChildren.end(), asteroidOwners[i]->getComponentId())) continue;
+
+        const AsteroidStart key{ asteroidOwners[i], 0.0f, 0.0f };
+        const auto found = std::lower_bound(asteroidStarts.begin(), asteroidStarts.end(), key, byOwner);
+        if (found == asteroidStarts.end() || found->owner != key.owner) continue;
+
+        asteroidColliders.startX[i] = found->x;
+        asteroidColliders.startY[i] = found->y;
+    }
+
+    indexAsteroids();
+}
+
+void Simulation::indexAsteroids()
+{
+    asteroidBroadphase.build(asteroidColliders);
+
+    float maxStepSquared = 0.0f;
+    for (std::size_t i = 0; i < asteroidColliders.size(); ++i)
+    {
+        const float dx = asteroidColliders.posX[i] - asteroidColliders.startX[i];
+        const float dy = asteroidColliders.posY[i] - asteroidColliders.startY[i];
+        maxStepSquared = std::max(maxStepSquared, dx * dx + dy * dy);
+    }
+    maxAsteroidStep = std::sqrt(maxStepSquared);
+}
+
+// The first asteroid a circle moving from `from` to `to` this step touches,
+// each asteroid moving from where its step started to where it is; the lowest
+// index on ties, so the result does not depend on candidate order.
+// Out-of-bounds asteroids are about to be released and never count.
+//
+// Anything the sweep can touch lies within the circle around the path's
+// midpoint grown by half the path and the farthest asteroid step, so that
+// circle's overlap test narrows the candidates before the swept test.
+std::uint32_t Simulation::firstAsteroidHit(const sf::Vector2f& from, const sf::Vector2f& to, float radius)
+{
+    const sf::Vector2f middle = (from + to) * 0.5f;
+    const sf::Vector2f path = to - from;
+    const float reach = radius + 0.5f * std::sqrt(path.x * path.x + path.y * path.y) + maxAsteroidStep;
+
+    candidates.clear();
+    asteroidBroadphase.queryCircle(middle.x, middle.y, reach, candidates);
+    Narrowphase::filterCandidates(asteroidColliders, middle.x, middle.y, reach, candidates, hits);
+
+    std::uint32_t first = NoCollider;
+    float firstTime = 2.0f;
+    for (std::uint32_t i : hits)
+    {
+        const float x = asteroidColliders.posX[i], y = asteroidColliders.posY[i];
+        if (asteroidColliders.radius[i] <= 0.0f || isOutOfBounds({ x, y })) continue;
+
+        const float time = Narrowphase::sweptContact(from.x, from.y, to.x, to.y,
+            asteroidColliders.startX[i], asteroidColliders.startY[i], x, y,
+            radius + asteroidColliders.radius[i]);
+        if (time == Narrowphase::NoContact) continue;
+
+        if (time < firstTime || (time == firstTime && i < first))
+        {
+            first = i;
+            firstTime = time;
+        }
+    }
+    return first;
+}
+
+void Simulation::finish(State result)
+{
+    state = result;
+
+    world.bulletPool.releaseAll();
+    world.asteroidPool.releaseAll();
+}
+
+void Simulation::tryShoot(const sf::Vector2f& aim)
+{
+    if (shootTimer.getElapsedTime().asSeconds() <= shootCooldown) return;
+
+    Bullet* bullet = world.bulletPool.acquire();
+    if (bullet)
+    {
+        ComponentRegistry& registry = world.components;
+        const sf::Vector2f playerPosition = player.getPosition();
+        sf::Vector2f direction = aim - playerPosition;
+        normalizeVector(direction);
+        registry.transforms.write(bullet->getId(), [&](Transform& transform) { transform.position = playerPosition; });
+        registry.velocities.write(bullet->getId(), [&](Velocity& velocity) { velocity.direction = direction; });
+    }
+
+    shootTimer.restart();
+}
+
+void Simulation::trySpawnAsteroid()
+{
+    if (asteroidTimer.getElapsedTime().asSeconds() <= asteroidCooldown) return;
+
+    Asteroid* asteroid = world.asteroidPool.acquire();
+    if (!asteroid) return;
+
+    float x, y;
+    float spawnMargin = 50.0f;
+    int side = world.random.next() % 4;
+
+    switch (side) {
+    case 0: // Up
+        x = world.random.next() % arenaSize.x;
+        y = -spawnMargin;
+        break;
+    case 1: // Down
+        x = world.random.next() % arenaSize.x;
+        y = arenaSize.y + spawnMargin;
+        break;
+    case 2: // Left
+        x = -spawnMargin;
+        y = world.random.next() % arenaSize.y;
+        break;
+    case 3: // Right
+        x = arenaSize.x + spawnMargin;
+        y = world.random.next() % arenaSize.y;
+        break;
+    default:
+        x = 0;
+        y = 0;
+        break;
+    }
+
+    sf::Vector2f center;
+    if (isPlayerInsideZone)
+    {
+        center = player.getPosition();
+    }
+    else
+    {
+        // Drawn one statement at a time: argument evaluation order varies
+        // between compilers, and replays must not.
+        const int offsetX = world.random.next() % 500 - 250;
+        const int offsetY = world.random.next() % 500 - 250;
+        center = sf::Vector2f(arenaSize.x / 2.0f + offsetX, arenaSize.y / 2.0f + offsetY);
+    }
+
+    sf::Vector2f direction = center - sf::Vector2f(x, y);
+    normalizeVector(direction);
+
+    const int level = world.random.next() % 3 + 1;
+    const float speedOffset = static_cast<float>(world.random.next() % 200 - 100);
+
+    if (auto edit = world.asteroids.edit(asteroid->getComponentId()))
+    {
+        edit.setPosition({ x, y });
+        edit.setDirection(direction);
+        edit.setLevel(level);
+        edit.setSpeed(edit.getDefaultSpeed() + speedOffset);
+    }
+
+    asteroidTimer.restart();
+}
+
+// Level-1 asteroids are destroyed; bigger ones drop a level and shed a child.
+// The random draws happen here, in dense index order, so replays stay
+// deterministic.
+void Simulation::splitPendingAsteroids()
+{
+    if (pendingSplits.empty()) return;
+
+    splitBatch.clear();
+    for (std::uint32_t index : pendingSplits)
+    {
+        Asteroid* asteroid = asteroidOwners[index];
+        if (asteroid->getLevel() <= 1)
+        {
+            world.asteroidPool.release(asteroid);
+            continue;
+        }
+
+        AsteroidComponentManager::SplitDesc split;
+        split.parent = asteroid->getComponentId();
+
+        if (Asteroid* child = world.asteroidPool.acquire())
+        {
+            split.child = child->getComponentId();
+            split.childAngle = static_cast<float>(world.random.next() % 50 - 25);
+            split.parentAngle = static_cast<float>(world.random.next() % 50 - 25);
+            split.childSpeedOffset = static_cast<float>(world.random.next() % 200 - 100);
+            split.parentSpeedOffset = static_cast<float>(world.random.next() % 200 - 100);
+        }
+
+        splitBatch.push_back(split);
+    }
+    pendingSplits.clear();
+
+    world.asteroids.splitBatch(Span<const AsteroidComponentManager::SplitDesc>(splitBatch));
+}
+
+void Simulation::spawnZone()
+{
+    if (zonesCompleted > 2)
+    {
+        finish(State::Won);
+        return;
+    }
+
+    sf::Vector2u zoneLocation;
+    zoneLocation.x = arenaSize.x / 4 * (zonesCompleted + 1);
+    zoneLocation.y = arenaSize.y / 2;
+
+    zone.setPosition(sf::Vector2f(zoneLocation));
+}
+
+bool Simulation::isOutOfBounds(const sf::Vector2f& position) const
+{
+    float left = 0 - gameZoneMargin;
+    float right = arenaSize.x + gameZoneMargin;
+    float top = 0 - gameZoneMargin;
+    float bottom = arenaSize.y + gameZoneMargin;
+
+    bool outOfBounds = (position.x <= left || position.x >= right || position.y <= top || position.y >= bottom);
+    return outOfBounds;
+}
+
+// Circles overlap: centres closer than the sum of the collider radii.
+bool Simulation::intersects(EntityId a, EntityId b) const
+{
+    const ComponentRegistry& registry = world.components;
+    const sf::Vector2f offset = registry.transforms.get(a).position - registry.transforms.get(b).position;
+    const float minDist = registry.colliders.get(a).radius + registry.colliders.get(b).radius;
+    return offset.x * offset.x + offset.y * offset.y < minDist * minDist;
+}
+
+void Simulation::constrainPlayerMovement()
+{
+    sf::Vector2f playerCorrectedPosition;
+    playerCorrectedPosition.x = std::clamp(player.getPosition().x, player.getRadius(), static_cast<float>(arenaSize.x) - player.getRadius());
+    playerCorrectedPosition.y = std::clamp(player.getPosition().y, player.getRadius(), static_cast<float>(arenaSize.y) - player.getRadius());
+    player.setPosition(playerCorrectedPosition);
+}
+
+void Simulation::normalizeVector(sf::Vector2f& vector)
+{
+    float length = std::sqrt(vector.x * vector.x + vector.y * vector.y);
+    if (length > 0) {
+        vector.x /= length;
+        vector.y /= length;
+    }
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+#include "AsteroidComponent.h"
+#include "Broadphase.h"
+#include "ColliderBatch.h"
+#include "ComponentManager.h"
+#include "Kinematics.h"
+#include "Player.h"
+#include "SimClock.h"
+#include "SortAndSweep.h"
+#include "Zone.h"
+
+class Asteroid;
+class World;
+
+// Everything the player controls during one tick. Whoever drives the
+// simulation fills it in: Game from the keyboard and mouse, a headless run
+// from a script or an agent.
+struct InputState
+{
+    // -1 reverse, 0 coast, 1 forward.
+    float thrust{};
+    // -1 left, 0 straight, 1 right.
+    float turn{};
+    // Shoot this tick, if the cooldown allows.
+    bool fire{};
+    // Where to shoot, in arena coordinates.
+    sf::Vector2f aim{};
+};
+
+// The game rules without a window: spawning, movement, collisions, zones and
+// scoring over a World, advanced one fixed tick at a time. It links against
+// no graphics, so it can run headless, faster than real time, or many at
+// once on separate worlds. Game wraps it with a window and input.
+class Simulation
+{
+public:
+    enum class State { Idle, Running, Lost, Won };
+
+    static constexpr float DefaultTimeStep = 1.0f / 60.0f;
+
+    // Collisions are swept over each step, so a longer timeStep costs
+    // accuracy of motion but does not let bullets pass through asteroids.
+    Simulation(World& world, const sf::Vector2u& arenaSize, float timeStep = DefaultTimeStep);
+
+    // Starts a new session. The seed and the InputState of every step fully
+    // determine it.
+    void start(std::uint32_t seed);
+
+    // Advances one timeStep. Does nothing unless Running.
+    void step(const InputState& input);
+
+    State getState() const noexcept { return state; }
+    std::uint64_t getTick() const noexcept { return tick; }
+    int getScore() const noexcept { return score; }
+    int getZonesCompleted() const noexcept { return zonesCompleted; }
+    float getPlaytime() const noexcept { return playtimeTimer.getElapsedTime().asSeconds(); }
+    bool getIsPlayerInsideZone() const noexcept { return isPlayerInsideZone; }
+    float getZoneTimeRemaining() const noexcept { return timeToCompleteZone - zoneTimer.getElapsedTime().asSeconds(); }
+    const sf::Vector2u& getArenaSize() const noexcept { return arenaSize; }
+    float getTimeStep() const noexcept { return timeStep; }
+
+    // Asteroids bounce off each other instead of passing through, for the
+    // dense mode. Off by default; input logs record it (see InputLog.h).
+    void setAsteroidCollisions(bool enabled) noexcept { asteroidCollisions = enabled; }
+    bool getAsteroidCollisions() const noexcept { return asteroidCollisions; }
+
+private:
+    World& world;
+    sf::Vector2u arenaSize;
+    float timeStep;
+    bool asteroidCollisions{ false };
+
+    State state{ State::Idle };
+    std::uint64_t tick{};
+
+    Player player;
+    // Scratch for moveEntities: positions of everything with a Velocity.
+    Kinematics::Batch movementBatch;
+    // Dense indices of the asteroids hit this tick, split together after the
+    // bullet pass.
+    std::vector<std::uint32_t> pendingSplits;
+    std::vector<AsteroidComponentManager::SplitDesc> splitBatch;
+    // Asteroid colliders gathered for this tick's collision passes, the
+    // Asteroid behind each one, and the broadphase built over them.
+    ColliderBatch asteroidColliders;
+    std::vector<Asteroid*> asteroidOwners;
+    AsteroidBroadphase asteroidBroadphase;
+    // Asteroid positions before this step's updateAll, by dense index.
+    // Nothing is created or destroyed until the bullet pass, so index i is
+    // the same asteroid in the first gather of the step.
+    ColliderBatch::Column<float> asteroidStartX, asteroidStartY;
+    // The same starts by owner, carried across the regather after splits.
+    struct AsteroidStart
+    {
+        Asteroid* owner;
+        float x, y;
+    };
+    std::vector<AsteroidStart> asteroidStarts;
+    std::vector<AsteroidComponentManager::Id> splitChildren;
+    // Farthest any asteroid moved this step.
+    float maxAsteroidStep{};
+    std::vector<std::uint32_t> candidates;
+    std::vector<std::uint32_t> hits;
+    // Asteroid-asteroid pass: the sweep persists so its order stays nearly
+    // sorted from tick to tick.
+    SortAndSweep asteroidSweep;
+    std::vector<ColliderPair> asteroidPairs;
+    std::vector<ColliderPair> asteroidContacts;
+
+    Zone zone;
+    SimClock zoneTimer;
+    SimClock playtimeTimer;
+    float timeToCompleteZone;
+    int zonesCompleted{};
+    bool isPlayerInsideZone{ false };
+
+    float shootCooldown;
+    SimClock shootTimer;
+    float asteroidCooldown;
+    SimClock asteroidTimer;
+
+    float gameZoneMargin;
+    int pointsPerAsteroidLevel;
+    int pointsPerZoneComplete;
+    int score{};
+
+    void advanceTimers(float deltaTime);
+    void moveEntities(float deltaTime);
+    void collideAsteroids();
+    void checkCollisions();
+    void gatherAsteroids();
+    void splitAndRegatherAsteroids();
+    void indexAsteroids();
+    std::uint32_t firstAsteroidHit(const sf::Vector2f& from, const sf::Vector2f& to, float radius);
+    void finish(State result);
+
+    void tryShoot(const sf::Vector2f& aim);
+    void trySpawnAsteroid();
+    void splitPendingAsteroids();
+    void spawnZone();
+    bool isOutOfBounds(const sf::Vector2f& position) const;
+    bool intersects(EntityId a, EntityId b) const;
+
+    void constrainPlayerMovement();
+
+    static void normalizeVector(sf::Vector2f& vector);
+};
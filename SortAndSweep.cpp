@@ -0,0 +1,125 @@
+#include "SortAndSweep.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    bool precedes(std::int32_t rowA, float minXA, std::int32_t rowB, float minXB) noexcept
+    {
+        return rowA != rowB ? rowA < rowB : minXA < minXB;
+    }
+
+    template <typename Interval>
+    void pushIfOverlapsY(const Interval& a, const Interval& b, std::vector<ColliderPair>& out)
+    {
+        if (b.minY > a.maxY || b.maxY < a.minY) return;
+        out.push_back(a.index < b.index ? ColliderPair{ a.index, b.index } : ColliderPair{ b.index, a.index });
+    }
+}
+
+SortAndSweep::Interval SortAndSweep::intervalOf(const ColliderBatch& colliders, std::uint32_t index) const noexcept
+{
+    const float x = colliders.posX[index], y = colliders.posY[index], r = colliders.radius[index];
+    return Interval{ static_cast<std::int32_t>(std::floor(y * inverseRowHeight)), x - r, x + r, y - r, y + r, index };
+}
+
+void SortAndSweep::update(const ColliderBatch& colliders)
+{
+    const std::size_t count = colliders.size();
+
+    // A new row height invalidates every row, so everything is sorted afresh.
+    const float height = std::max(2.0f * colliders.maxRadius(), 1.0f);
+    if (height != rowHeight)
+    {
+        rowHeight = height;
+        inverseRowHeight = 1.0f / height;
+        intervals.clear();
+    }
+
+    // Every index below the old size is present. Keep those still in range
+    // and in the same row, in their old order; set aside those that moved.
+    const std::size_t kept = std::min(intervals.size(), count);
+    moved.clear();
+    std::size_t last = 0;
+    for (const Interval& interval : intervals)
+    {
+        if (interval.index >= count) continue;
+
+        const Interval current = intervalOf(colliders, interval.index);
+        if (current.row == interval.row) intervals[last++] = current;
+        else moved.push_back(current);
+    }
+    intervals.resize(last);
+
+    // Insertion sort: each circle moves left past those that now start after
+    // it. Strict comparison keeps equal edges in their previous order.
+    lastShifts = 0;
+    for (std::size_t i = 1; i < intervals.size(); ++i)
+    {
+        const Interval moving = intervals[i];
+        std::size_t j = i;
+        while (j > 0 && precedes(moving.row, moving.minX, intervals[j - 1].row, intervals[j - 1].minX))
+        {
+            intervals[j] = intervals[j - 1];
+            --j;
+        }
+        lastShifts += i - j;
+        intervals[j] = moving;
+    }
+
+    for (std::size_t i = kept; i < count; ++i) moved.push_back(intervalOf(colliders, static_cast<std::uint32_t>(i)));
+
+    const auto byKey = [](const Interval& a, const Interval& b) { return precedes(a.row, a.minX, b.row, b.minX); };
+    std::sort(moved.begin(), moved.end(), byKey);
+    const std::size_t sorted = intervals.size();
+    intervals.insert(intervals.end(), moved.begin(), moved.end());
+    std::inplace_merge(intervals.begin(), intervals.begin() + sorted, intervals.end(), byKey);
+
+    runs.clear();
+    for (std::uint32_t i = 0; i < intervals.size(); ++i)
+    {
+        if (runs.empty() || runs.back().row != intervals[i].row) runs.push_back(Run{ intervals[i].row, i, i });
+        runs.back().end = i + 1;
+    }
+}
+
+void SortAndSweep::findPairs(std::vector<ColliderPair>& out) const
+{
+    for (std::size_t r = 0; r < runs.size(); ++r)
+    {
+        sweepRun(runs[r], out);
+        if (r + 1 < runs.size() && runs[r + 1].row == runs[r].row + 1) sweepRuns(runs[r], runs[r + 1], out);
+    }
+}
+
+void SortAndSweep::sweepRun(const Run& run, std::vector<ColliderPair>& out) const
+{
+    for (std::uint32_t i = run.begin; i < run.end; ++i)
+    {
+        const Interval& a = intervals[i];
+        for (std::uint32_t j = i + 1; j < run.end && intervals[j].minX <= a.maxX; ++j) pushIfOverlapsY(a, intervals[j], out);
+    }
+}
+
+// Two x extents overlap when one starts within the other, so each side in
+// turn looks for the other side's circles starting within it: those starting
+// at or after it from the upper run, strictly after it from the lower one,
+// so that equal starts are counted once.
+void SortAndSweep::sweepRuns(const Run& upper, const Run& lower, std::vector<ColliderPair>& out) const
+{
+    std::uint32_t first = lower.begin;
+    for (std::uint32_t i = upper.begin; i < upper.end; ++i)
+    {
+        const Interval& a = intervals[i];
+        while (first < lower.end && intervals[first].minX < a.minX) ++first;
+        for (std::uint32_t j = first; j < lower.end && intervals[j].minX <= a.maxX; ++j) pushIfOverlapsY(a, intervals[j], out);
+    }
+
+    first = upper.begin;
+    for (std::uint32_t i = lower.begin; i < lower.end; ++i)
+    {
+        const Interval& b = intervals[i];
+        while (first < upper.end && intervals[first].minX <= b.minX) ++first;
+        for (std::uint32_t j = first; j < upper.end && intervals[j].minX <= b.maxX; ++j) pushIfOverlapsY(b, intervals[j], out);
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ColliderBatch.h"
+
+// Pair-only broadphase: circles kept sorted along x, swept for those whose
+// x extents overlap, and tested along y.
+//
+// A single sorted list over a square arena pairs each circle with a whole
+// column's worth of others, so the count grows with the square root of the
+// population. The list is therefore sorted by row first: rows are as tall as
+// the largest circle is wide, so touching circles sit in the same row or in
+// neighbouring ones, and each row is swept against itself and the row below.
+//
+// Unlike SpatialHash and LooseQuadtree it is not rebuilt: the sorted order
+// persists between updates and is repaired with an insertion sort. Circles
+// move little per tick, so the order is nearly right and the repair is close
+// to linear. Circles new since the last update, or that changed row, are
+// sorted on their own and merged in.
+//
+// The order is kept by index into the ColliderBatch, so it only stays nearly
+// sorted while an index keeps naming the same circle, which holds for
+// AsteroidComponentManager::gatherColliders: removing an asteroid moves just
+// the last one into its place.
+class SortAndSweep
+{
+public:
+    // Brings the order up to date with colliders. Indices past its end are
+    // dropped and new ones added, so the batch may grow and shrink freely.
+    void update(const ColliderBatch& colliders);
+
+    // Appends every pair of circles whose bounds overlap, each once. May
+    // include some that do not overlap; follow with Narrowphase::filterPairs.
+    void findPairs(std::vector<ColliderPair>& out) const;
+
+    std::size_t size() const noexcept { return intervals.size(); }
+    float getRowHeight() const noexcept { return rowHeight; }
+    // Places the last update's insertion sort moved circles by, in total:
+    // small while the order stays coherent from tick to tick.
+    std::size_t getLastShifts() const noexcept { return lastShifts; }
+
+private:
+    struct Interval
+    {
+        std::int32_t row;
+        float minX, maxX;
+        float minY, maxY;
+        std::uint32_t index;
+    };
+
+    // Intervals [begin, end) all lie in row.
+    struct Run
+    {
+        std::int32_t row;
+        std::uint32_t begin, end;
+    };
+
+    Interval intervalOf(const ColliderBatch& colliders, std::uint32_t index) const noexcept;
+    void sweepRun(const Run& run, std::vector<ColliderPair>& out) const;
+    void sweepRuns(const Run& upper, const Run& lower, std::vector<ColliderPair>& out) const;
+
+    // Sorted by row, then minX.
+    std::vector<Interval> intervals;
+    std::vector<Run> runs;
+    // Circles moved out of the sorted order this update, to be merged back.
+    std::vector<Interval> moved;
+
+    float rowHeight{};
+    float inverseRowHeight{};
+    std::size_t lastShifts{};
+};
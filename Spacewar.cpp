@@ -1,9 +1,25 @@
 #include <SFML/Graphics.hpp>
+#include <cstdlib>
+#include <string>
 #include "Game.h"
+#include "World.h"
 
-int main()
+// Spacewar [--dense] [--record <file>] [--replay <file> [--session <n>] [--fast]]
+int main(int argc, char* argv[])
 {
-    Game game;
+    GameOptions options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--record" && i + 1 < argc) options.recordPath = argv[++i];
+        else if (arg == "--replay" && i + 1 < argc) options.replayPath = argv[++i];
+        else if (arg == "--session" && i + 1 < argc) options.replaySession = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--fast") options.replayFast = true;
+        else if (arg == "--dense") options.asteroidCollisions = true;
+    }
+
+    World world;
+    Game game(world, options);
 
     game.run();
 }
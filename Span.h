@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Non-owning view over a contiguous range, for the C++17 build (no std::span).
+template<typename T>
+class Span
+{
+public:
+    constexpr Span() noexcept = default;
+    constexpr Span(T* data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+    template<typename U>
+    Span(const std::vector<U>& v) noexcept : data_(v.data()), size_(v.size()) {}
+    template<typename U>
+    Span(std::vector<U>& v) noexcept : data_(v.data()), size_(v.size()) {}
+
+    constexpr T* data() const noexcept { return data_; }
+    constexpr std::size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    constexpr T& operator[](std::size_t i) const noexcept { return data_[i]; }
+
+    constexpr T* begin() const noexcept { return data_; }
+    constexpr T* end() const noexcept { return data_ + size_; }
+
+private:
+    T* data_{ nullptr };
+    std::size_t size_{ 0 };
+};
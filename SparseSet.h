@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Span.h"
+
+// Associates small integer ids with values kept in one packed array.
+//
+// The sparse side maps an id's slot to the position of its value in the dense
+// arrays, so lookup is a few array reads with no hashing. erase() moves the last value into the
+// hole (swap-remove): values stay contiguous for linear iteration, but their
+// order is not preserved. The sparse side grows with the largest slot ever
+// inserted, so ids should be recycled rather than allocated forever.
+//
+// An id's low SparseId::SlotBits name its slot in the sparse side; the bits
+// above are a generation, kept in the slot beside the index. A recycled id
+// comes back as nextGeneration(id), so lookups with the old one no longer
+// resolve. Generations wrap, as PoolHandle's do.
+namespace SparseId
+{
+    template <typename Id>
+    constexpr unsigned SlotBits = sizeof(Id) >= 8 ? 32 : 22;
+
+    // Allocators must hand out slots below this; higher bits are generation.
+    template <typename Id>
+    constexpr std::uint64_t SlotLimit = std::uint64_t{ 1 } << SlotBits<Id>;
+
+    template <typename Id>
+    constexpr std::size_t slotOf(Id id) noexcept { return static_cast<std::size_t>(static_cast<std::uint64_t>(id) & (SlotLimit<Id> - 1)); }
+
+    template <typename Id>
+    constexpr std::uint32_t generationOf(Id id) noexcept { return static_cast<std::uint32_t>(static_cast<std::uint64_t>(id) >> SlotBits<Id>); }
+
+    // The id naming the same slot once id has been erased.
+    template <typename Id>
+    constexpr Id nextGeneration(Id id) noexcept { return static_cast<Id>(id + (Id{ 1 } << SlotBits<Id>)); }
+}
+
+template <typename T, typename Id = std::size_t>
+class SparseSet
+{
+public:
+    using ValueType = T;
+    using IdType = Id;
+
+    static constexpr std::uint32_t Npos = static_cast<std::uint32_t>(-1);
+
+    bool contains(Id id) const noexcept { return indexOf(id) != Npos; }
+
+    // Replaces the value if id is already present. The slot must not hold
+    // another generation of id.
+    template <typename... Args>
+    T& emplace(Id id, Args&&... args) {
+        const std::uint32_t existing = indexOf(id);
+        if (existing != Npos) {
+            T& value = dense[existing];
+            value = T(std::forward<Args>(args)...);
+            return value;
+        }
+
+        const std::size_t slot = SparseId::slotOf(id);
+        if (slot >= sparse.size()) sparse.resize(slot + 1, Slot{});
+        assert(sparse[slot].index == Npos && "SparseSet: slot holds another generation");
+
+        dense.emplace_back(std::forward<Args>(args)...);
+        denseIds.push_back(id);
+        sparse[slot] = Slot{ static_cast<std::uint32_t>(dense.size() - 1), SparseId::generationOf(id) };
+        return dense.back();
+    }
+
+    // O(1). The last value takes the erased one's place.
+    bool erase(Id id) {
+        const std::uint32_t index = indexOf(id);
+        if (index == Npos) return false;
+
+        const std::uint32_t last = static_cast<std::uint32_t>(dense.size() - 1);
+        if (index != last) {
+            dense[index] = std::move(dense[last]);
+            denseIds[index] = denseIds[last];
+            sparse[SparseId::slotOf(denseIds[index])].index = index;
+        }
+        dense.pop_back();
+        denseIds.pop_back();
+        sparse[SparseId::slotOf(id)] = Slot{};
+        return true;
+    }
+
+    T* find(Id id) noexcept {
+        const std::uint32_t index = indexOf(id);
+        return index != Npos ? &dense[index] : nullptr;
+    }
+    const T* find(Id id) const noexcept {
+        const std::uint32_t index = indexOf(id);
+        return index != Npos ? &dense[index] : nullptr;
+    }
+
+    // Position of id in the dense arrays, or Npos. The generation lives next
+    // to the index, so a stale id is told apart without touching dense data.
+    std::uint32_t indexOf(Id id) const noexcept {
+        const std::size_t slot = SparseId::slotOf(id);
+        if (slot >= sparse.size()) return Npos;
+        const Slot entry = sparse[slot];
+        return entry.generation == SparseId::generationOf(id) ? entry.index : Npos;
+    }
+    Id idAt(std::size_t index) const noexcept { return denseIds[index]; }
+
+    // Exchanges the values at two dense positions, e.g. to line this set up
+    // with another one.
+    void swapAt(std::size_t a, std::size_t b) {
+        if (a == b) return;
+        using std::swap;
+        swap(dense[a], dense[b]);
+        swap(denseIds[a], denseIds[b]);
+        sparse[SparseId::slotOf(denseIds[a])].index = static_cast<std::uint32_t>(a);
+        sparse[SparseId::slotOf(denseIds[b])].index = static_cast<std::uint32_t>(b);
+    }
+
+    void reserve(std::size_t count) {
+        dense.reserve(count);
+        denseIds.reserve(count);
+    }
+
+    // Sizes the sparse side for slots below slotCount, so emplace() with ids
+    // in those slots never reallocates it.
+    void reserveIds(std::size_t slotCount) {
+        if (sparse.size() < slotCount) sparse.resize(slotCount, Slot{});
+    }
+
+    void clear() noexcept {
+        for (Id id : denseIds) sparse[SparseId::slotOf(id)] = Slot{};
+        dense.clear();
+        denseIds.clear();
+    }
+
+    std::size_t size() const noexcept { return dense.size(); }
+    bool empty() const noexcept { return dense.empty(); }
+
+    // Packed values and their ids, index for index. Erasing invalidates both.
+    Span<T> values() noexcept { return Span<T>(dense); }
+    Span<const T> values() const noexcept { return Span<const T>(dense); }
+    Span<const Id> ids() const noexcept { return Span<const Id>(denseIds); }
+
+    T* begin() noexcept { return dense.data(); }
+    T* end() noexcept { return dense.data() + dense.size(); }
+    const T* begin() const noexcept { return dense.data(); }
+    const T* end() const noexcept { return dense.data() + dense.size(); }
+
+private:
+    // Dense position and generation of the id in a slot. A free slot's index
+    // is Npos, so it resolves no id whatever its generation.
+    struct Slot
+    {
+        std::uint32_t index{ Npos };
+        std::uint32_t generation{ 0 };
+    };
+
+    std::vector<Slot> sparse;
+    std::vector<T> dense;
+    std::vector<Id> denseIds;
+};
@@ -0,0 +1,162 @@
+#include "SpatialHash.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void SpatialHash::build(const ColliderBatch& newColliders)
+{
+    colliders = &newColliders;
+    const std::size_t count = newColliders.size();
+
+    maxRadius = newColliders.maxRadius();
+    cellSize = std::max(2.0f * maxRadius, 1.0f);
+    inverseCellSize = 1.0f / cellSize;
+
+    // About two buckets per circle keeps unrelated cells from sharing one.
+    std::size_t bucketCount = 16;
+    while (bucketCount < count * 2) bucketCount *= 2;
+    bucketMask = static_cast<std::uint32_t>(bucketCount - 1);
+
+    bucketStart.assign(bucketCount + 1, 0);
+    filed.resize(count);
+    entries.resize(count);
+
+    minCellX = minCellY = std::numeric_limits<std::int32_t>::max();
+    maxCellX = maxCellY = std::numeric_limits<std::int32_t>::min();
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const std::int32_t cellX = cellOf(newColliders.posX[i]);
+        const std::int32_t cellY = cellOf(newColliders.posY[i]);
+        filed[i] = Entry{ static_cast<std::uint32_t>(i), cellX, cellY };
+        ++bucketStart[bucketOf(cellX, cellY) + 1];
+
+        minCellX = std::min(minCellX, cellX);
+        maxCellX = std::max(maxCellX, cellX);
+        minCellY = std::min(minCellY, cellY);
+        maxCellY = std::max(maxCellY, cellY);
+    }
+
+    for (std::size_t b = 0; b < bucketCount; ++b) bucketStart[b + 1] += bucketStart[b];
+
+    // Scatter through a moving cursor per bucket; bucketStart[b] ends up at
+    // the end of bucket b, i.e. the start of bucket b + 1, so shift it back.
+    for (const Entry& entry : filed)
+    {
+        entries[bucketStart[bucketOf(entry.cellX, entry.cellY)]++] = entry;
+    }
+    for (std::size_t b = bucketCount; b > 0; --b) bucketStart[b] = bucketStart[b - 1];
+    bucketStart[0] = 0;
+}
+
+template <typename Fn>
+void SpatialHash::forEachInCells(std::int32_t minX, std::int32_t maxX, std::int32_t minY, std::int32_t maxY, Fn&& fn) const
+{
+    for (std::int32_t cellY = minY; cellY <= maxY; ++cellY)
+    {
+        for (std::int32_t cellX = minX; cellX <= maxX; ++cellX)
+        {
+            const std::uint32_t bucket = bucketOf(cellX, cellY);
+            for (std::uint32_t e = bucketStart[bucket]; e < bucketStart[bucket + 1]; ++e)
+            {
+                const Entry& entry = entries[e];
+                if (entry.cellX == cellX && entry.cellY == cellY) fn(entry.index);
+            }
+        }
+    }
+}
+
+void SpatialHash::queryCircle(float x, float y, float radius, std::vector<std::uint32_t>& out) const
+{
+    if (entries.empty()) return;
+
+    // Only cells between the occupied extremes can hold anything, so a query
+    // far larger than the arena, or outside it, walks no empty cells.
+    const float reach = radius + maxRadius;
+    const std::int32_t minX = std::max(cellOf(x - reach), minCellX), maxX = std::min(cellOf(x + reach), maxCellX);
+    const std::int32_t minY = std::max(cellOf(y - reach), minCellY), maxY = std::min(cellOf(y + reach), maxCellY);
+    if (minX > maxX || minY > maxY) return;
+
+    forEachInCells(minX, maxX, minY, maxY, [&](std::uint32_t index) { out.push_back(index); });
+}
+
+// Searches rings of cells outward from the point's own cell until no circle
+// in a farther ring could beat the best so far. A point far from every
+// circle would need many empty rings, so past the point where a ring costs
+// more than the circles themselves it scans them all instead.
+std::uint32_t SpatialHash::nearest(float x, float y) const
+{
+    if (entries.empty()) return NoCollider;
+
+    std::uint32_t best = NoCollider;
+    float bestDistance = std::numeric_limits<float>::infinity();
+    auto consider = [&](std::uint32_t index)
+    {
+        const float dx = x - colliders->posX[index];
+        const float dy = y - colliders->posY[index];
+        const float distance = std::sqrt(dx * dx + dy * dy) - colliders->radius[index];
+        if (distance < bestDistance || (distance == bestDistance && index < best))
+        {
+            best = index;
+            bestDistance = distance;
+        }
+    };
+
+    const std::int32_t centerX = cellOf(x), centerY = cellOf(y);
+    for (std::int32_t ring = 0;; ++ring)
+    {
+        if (static_cast<std::size_t>(8 * ring) > entries.size())
+        {
+            best = NoCollider;
+            bestDistance = std::numeric_limits<float>::infinity();
+            for (std::uint32_t i = 0; i < entries.size(); ++i) consider(i);
+            return best;
+        }
+
+        const std::int32_t minX = centerX - ring, maxX = centerX + ring;
+        const std::int32_t minY = centerY - ring, maxY = centerY + ring;
+        if (ring == 0)
+        {
+            forEachInCells(minX, maxX, minY, maxY, consider);
+        }
+        else
+        {
+            forEachInCells(minX, maxX, minY, minY, consider);
+            forEachInCells(minX, maxX, maxY, maxY, consider);
+            forEachInCells(minX, minX, minY + 1, maxY - 1, consider);
+            forEachInCells(maxX, maxX, minY + 1, maxY - 1, consider);
+        }
+
+        const bool coveredAll = minX <= minCellX && maxX >= maxCellX && minY <= minCellY && maxY >= maxCellY;
+        // Centres in the next ring are at least ring cells away.
+        if (coveredAll || ring * cellSize - maxRadius > bestDistance) return best;
+    }
+}
+
+// Each circle against the cells its own reach overlaps, keeping only pairs
+// where it has the lower index so every pair comes out once.
+void SpatialHash::findPairs(std::vector<ColliderPair>& out) const
+{
+    for (const Entry& entry : entries)
+    {
+        const float x = colliders->posX[entry.index];
+        const float y = colliders->posY[entry.index];
+        const float reach = colliders->radius[entry.index] + maxRadius;
+
+        forEachInCells(cellOf(x - reach), cellOf(x + reach), cellOf(y - reach), cellOf(y + reach),
+            [&](std::uint32_t other)
+            {
+                if (other > entry.index) out.push_back(ColliderPair{ entry.index, other });
+            });
+    }
+}
+
+std::int32_t SpatialHash::cellOf(float coordinate) const noexcept
+{
+    return static_cast<std::int32_t>(std::floor(coordinate * inverseCellSize));
+}
+
+std::uint32_t SpatialHash::bucketOf(std::int32_t cellX, std::int32_t cellY) const noexcept
+{
+    return ((static_cast<std::uint32_t>(cellX) * 73856093u) ^ (static_cast<std::uint32_t>(cellY) * 19349663u)) & bucketMask;
+}
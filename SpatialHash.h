@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ColliderBatch.h"
+
+// Uniform grid broadphase over circles, hashed so the arena needs no bounds.
+// Each circle is filed under the cell holding its centre. Cells are twice the
+// largest radius, so a query only visits the cells its circle, grown by that
+// radius, overlaps: 2x2 or 3x3 for a bullet or the player. One large circle
+// makes every cell large, which is what LooseQuadtree is for.
+//
+// Rebuilt from scratch every tick with a counting sort: two linear passes,
+// no per-cell allocations, and storage is kept between ticks. Implements the
+// broadphase interface described in Broadphase.h.
+class SpatialHash
+{
+public:
+    void build(const ColliderBatch& colliders);
+
+    void queryCircle(float x, float y, float radius, std::vector<std::uint32_t>& out) const;
+    std::uint32_t nearest(float x, float y) const;
+    void findPairs(std::vector<ColliderPair>& out) const;
+
+    float getCellSize() const noexcept { return cellSize; }
+    std::size_t size() const noexcept { return entries.size(); }
+
+private:
+    struct Entry
+    {
+        std::uint32_t index;
+        std::int32_t cellX, cellY;
+    };
+
+    std::int32_t cellOf(float coordinate) const noexcept;
+    std::uint32_t bucketOf(std::int32_t cellX, std::int32_t cellY) const noexcept;
+
+    // fn(index) for every circle filed in the cells [minX, maxX] x [minY, maxY].
+    template <typename Fn>
+    void forEachInCells(std::int32_t minX, std::int32_t maxX, std::int32_t minY, std::int32_t maxY, Fn&& fn) const;
+
+    const ColliderBatch* colliders{ nullptr };
+
+    float cellSize{ 1.0f };
+    float inverseCellSize{ 1.0f };
+    // Radius every query is grown by: circles are filed by centre only.
+    float maxRadius{};
+    // Cells that hold at least one circle lie within these.
+    std::int32_t minCellX{}, maxCellX{}, minCellY{}, maxCellY{};
+
+    // Entries sorted by bucket; bucket b holds entries[bucketStart[b], bucketStart[b + 1]).
+    // Different cells may share a bucket, hence the cell in each entry.
+    std::vector<Entry> entries;
+    std::vector<std::uint32_t> bucketStart;
+    // Entries in input order, before the sort.
+    std::vector<Entry> filed;
+    std::uint32_t bucketMask{};
+};
@@ -0,0 +1,8 @@
+#include "World.h"
+#include <new>
+
+World::World() :
+    bulletPool(20, FixedCapacity{}, EvictOldest{}, [this](void* where) { new (where) Bullet(*this); }),
+    asteroidPool(50, ChunkedGrowth{ 50, 1000 }, NoEviction{}, [this](void* where) { new (where) Asteroid(*this); })
+{
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Asteroid.h"
+#include "AsteroidComponent.h"
+#include "Bullet.h"
+#include "ComponentRegistry.h"
+#include "EventBus.h"
+#include "ObjectPool.h"
+#include "Random.h"
+
+// Everything one simulation shares: component stores, the event bus, pools
+// and random numbers. Nothing is process-wide, so any number of worlds can
+// exist at once, each driven by its own thread. A single world is stepped by
+// one thread at a time unless SPACEWAR_CONCURRENT_COMPONENTS is defined.
+class World
+{
+public:
+    World();
+
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+
+    EventBus events;
+    ComponentRegistry components;
+    AsteroidComponentManager asteroids;
+    Random random;
+
+    // After the stores: pooled objects release their components when the
+    // pools are destroyed.
+    ObjectPool<Bullet, FixedCapacity, EvictOldest> bulletPool;
+    ObjectPool<Asteroid, ChunkedGrowth> asteroidPool;
+};
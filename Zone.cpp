@@ -1,17 +1,24 @@
 #include "Zone.h"
-#include <SFML/Graphics/RenderWindow.hpp>
+#include "ComponentRegistry.h"
+#include "World.h"
 
-Zone::Zone()
+Zone::Zone(World& world) :
+	world(world)
 {
-	shape.setFillColor(sf::Color::Transparent);
-	shape.setRadius(300.0f);
-	shape.setPointCount(25);
-	shape.setOutlineColor(sf::Color::White);
-	shape.setOutlineThickness(2.0f);
-	shape.setOrigin({ shape.getRadius(), shape.getRadius() });
+	ComponentRegistry& registry = world.components;
+	id = registry.createEntity();
+	registry.transforms.add(id);
+	registry.velocities.add(id, Velocity{ {}, 0.0f, 25.0f });
+	registry.colliders.add(id, Collider{ Radius });
+	registry.renderables.add(id, Renderable{ Appearance::Zone });
 }
 
-void Zone::update(float deltaTime)
+Zone::~Zone()
 {
-	rotate(sf::degrees(25.0f * deltaTime));
+	world.components.destroyEntity(id);
+}
+
+void Zone::setPosition(const sf::Vector2f& position)
+{
+	world.components.transforms.write(id, [&](Transform& transform) { transform.position = position; });
 }
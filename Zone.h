@@ -1,17 +1,29 @@
 #pragma once
 
-#include "Entity.h"
+#include <SFML/System/Vector2.hpp>
+#include "ComponentManager.h"
 
-class Player;
+class World;
 
-class Zone : public Entity
+// The objective circle: an entity that spins in place (Velocity with only an
+// angular speed). This object owns the entity.
+class Zone
 {
 public:
-	Zone();
+	static constexpr float Radius = 300.0f;
 
-	virtual void update(float deltaTime) override;
+	explicit Zone(World& world);
+	~Zone();
 
-protected:
-	sf::CircleShape zoneCircle;
+	Zone(const Zone&) = delete;
+	Zone& operator=(const Zone&) = delete;
+
+	EntityId getId() const noexcept { return id; }
+
+	void setPosition(const sf::Vector2f& position);
+
+private:
+	World& world;
+	EntityId id{ 0 };
 
 };
@@ -1,9 +1,11 @@
 #include <SFML/Graphics.hpp>
 #include "Game.h"
+#include "World.h"
 
 int main()
 {
-    Game game;
+    World world;
+    Game game(world);
 
     game.run();
 }
\ No newline at end of file